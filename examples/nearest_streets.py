@@ -1,5 +1,4 @@
-from geodesk import Features, Box, from_mercator
-from shapely import *
+from geodesk import Features, Box, Coordinate
 
 coords = [
     (13.3898033, 52.5174377),
@@ -12,19 +11,17 @@ streets = germany("w[highway][maxspeed]")
 for c in coords:
     c_lon, c_lat = c
     box = Box(lon=c_lon, lat=c_lat).buffer(meters = 30)
-    p = Point(box.centroid)
+    p = Coordinate(lon=c_lon, lat=c_lat)
     nearby_streets = streets(box)
-    closest_street = None
-    closest_distance = 1000000
-    for street in nearby_streets:
-        d = p.distance(street.shape)
-        if d < closest_distance:
-            closest_street = street
-            closest_distance = d
-    if closest_street:
+    # Measures all streets in one call (on the query threads)
+    result = nearby_streets.distances(p, units="meters")
+    if len(result["value"]):
+        i = min(range(len(result["value"])), key=lambda i: result["value"][i])
+        closest_street = germany.way(result["id"][i])
+        closest_distance = result["value"][i]
         print(
             f"Closest street to ({c_lon}, {c_lat}) is {closest_street.name} "
-            f"at {from_mercator(closest_distance, unit='meters', lat=c_lat): .1f} meters, "
+            f"at {closest_distance: .1f} meters, "
             f"with maxspeed of {closest_street.maxspeed}")
     else:
-        print(f"Found no street near ({c_lon}, {c_lat})")
\ No newline at end of file
+        print(f"Found no street near ({c_lon}, {c_lat})")
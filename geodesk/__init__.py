@@ -1 +1,3 @@
-from ._geodesk import *
\ No newline at end of file
+from ._geodesk import *
+# Not exported by *, but needed to unpickle features and selections
+from ._geodesk import _restore_feature, _restore_features
@@ -1,6 +1,12 @@
 from shapely import Geometry, Polygon, MultiPolygon
 from shapely.geometry.base import BaseGeometry
-from typing import Callable, Dict, Iterator, List, Optional, Sequence, Tuple, Union, overload
+from typing import Any, AsyncIterator, Awaitable, Callable, Dict, Iterable, Iterator, List, Optional, Sequence, Tuple, Union, overload
+
+class Array(Sequence[Union[int, float, List[Union[int, float]]]]):
+    format: str
+    shape: Tuple[int, ...]
+    def tolist(self) -> list: ...
+    def __buffer__(self, flags: int) -> memoryview: ...
 
 class Box:
     def __init__(self, /, minx: float=..., miny: float=..., maxx: float=..., maxy: float=..., *,
@@ -79,10 +85,24 @@ class Feature:
     def str(self, key: 'str') -> 'str': ...
 
 class Features:
-    def __init__(self, filename: str) -> None: ...
+    # threads and max_buffered_results apply to this object and the
+    # selections derived from it (not to other Features of the same file);
+    # geometry_cache sets the budget of the cache that all Features of
+    # the file share, for as long as the file is open.
+    # max_buffered_results is a count of results (not a memory limit): the
+    # number of results that a query may have fetched from the engine, but
+    # not yet handed to its consumer. The engine's own result queue isn't
+    # limited, so memory use isn't bounded by this setting.
+    # queue_stats reports these counts (buffered_results,
+    # peak_buffered_results, max_buffered_results, producer_waits); results
+    # queued inside the engine aren't included.
+    def __init__(self, filename: str, *, threads: Optional[int] = ...,
+        max_buffered_results: Optional[int] = ...,
+        geometry_cache: Optional[int] = ...) -> None: ...
     area: float
     count: int
     first: Feature | None
+    geometry_cache_stats: Dict[str,int]
     geojson: 'Formatter'
     geojsonl: 'Formatter'
     indexed_keys: List[str]
@@ -92,21 +112,33 @@ class Features:
     nodes: Features
     one: 'Feature'
     properties: Dict[str,str]
+    queue_stats: Dict[str,int]
     relations: 'Features'
     revision: int
     shape: Geometry
-    strings: List[str]
+    strings: Sequence[str]
     tiles: List['Tile']
     timestamp: str
     ways: 'Features'
     wkt: 'Formatter'
+    def accessor(self, key: str, *, type: type=str) -> 'TagAccessor': ...
+    def acount(self) -> Awaitable[int]: ...
+    def afirst(self) -> Awaitable[Optional['Feature']]: ...
+    def aiter(self) -> AsyncIterator['Feature']: ...
     def around(self, geom: Union['Box', 'Coordinate', 'Feature', Geometry], *, meters: float, m: float, feet: float, ft: float, km: float, miles: float) -> 'Features': ...
     def connected_to(self, geom: Union['Box', 'Coordinate', 'Feature', Geometry]) -> 'Features': ...
     def containing(self, geom: Union['Box', 'Coordinate', 'Feature', Geometry]) -> 'Features': ...
     def contained_by(self, geom: Union['Box', 'Coordinate', 'Feature', Geometry]) -> 'Features': ...
     def crossing(self, geom: Union['Box', 'Coordinate', 'Feature', Geometry]) -> 'Features': ...
     def disjoint_from(self, geom: Union['Box', 'Coordinate', 'Feature', Geometry]) -> 'Features': ...
+    def distances(self, geom: Union['Box', 'Coordinate', 'Feature', Geometry],
+        units: str='meters') -> Dict[str, 'Array']: ...
+    def distinct(self, key: str) -> Dict[str, int]: ...
+    def grid(self, cell_size_meters: float, *, box: Optional['Box']=None,
+        value: str='count') -> 'Array': ...
+    def in_set(self, features: 'FeatureSet') -> 'Features': ...
     def intersecting(self, geom: Union['Box', 'Coordinate', 'Feature', Geometry]) -> 'Features': ...
+    def key_stats(self) -> Dict[str, int]: ...
     def max_area(self, n:float=None, *, 
         meters:float, m:float, feet:float, ft:float, km:float, miles:float) -> 'Features': ...
     def min_area(self, n:float=None, *, 
@@ -117,18 +149,43 @@ class Features:
         meters:float, m:float, feet:float, ft:float, km:float, miles:float) -> 'Features': ...
     def members_of(self, feature: 'Feature') -> 'Features': ...
     def node(self, id:int) -> 'Feature': ...
+    def nearest_to(self, geom: Union['Box', 'Coordinate', 'Feature', Geometry], k: int=1, *,
+        max_distance: Optional[float]=None, units: str='meters') -> List['Feature']: ...
     def nodes_of(self, feature: 'Feature') -> 'Features': ...
+    def num_array(self, key: str, *, default: float=...) -> Dict[str, 'Array']: ...
     def overlapping(self, geom: Union['Box', 'Coordinate', 'Feature', Geometry]) -> 'Features': ...
+    def parallel_map(self, func: Callable[['Feature'], Any], processes: Optional[int]=None,
+        chunk: str='tile') -> Iterator[Any]: ...
     def parents_of(self, feature: 'Feature') -> 'Features': ...
     def relation(self, id:int) -> 'Feature': ...
+    def sample(self, n: int, *, seed: Optional[int]=None,
+        stratify: Optional[str]=None) -> List['Feature']: ...
+    def tile_stats(self) -> Dict[str, 'Array']: ...
+    def top(self, k: int, by: str) -> List['Feature']: ...
     def touching(self, geom: Union['Box', 'Coordinate', 'Feature', Geometry]) -> 'Features': ...
     def way(self, id:int) -> 'Feature': ...
+    def with_ids(self, ids: Optional[Iterable[int]]=None, *, nodes: Optional[Iterable[int]]=None,
+        ways: Optional[Iterable[int]]=None, relations: Optional[Iterable[int]]=None) -> 'Features': ...
     def within(self, geom: Union['Box', 'Coordinate', 'Feature', Geometry]) -> 'Features': ...
     def __and__(self, other: "Features") -> "Features": ...
     def __iter__(self) -> Iterator['Feature']: ...
     def __contains__(self, item: 'Feature') -> bool: ...
     def __call__(self, arg: Union[str ,Box, 'Coordinate', 'Features']) -> Features: ...
     
+class FeatureSet:
+    def __init__(self, features: Union['Feature', 'Features', Iterable['Feature'], None]=None) -> None: ...
+    def add(self, feature: 'Feature') -> None: ...
+    def clear(self) -> None: ...
+    def discard(self, feature: 'Feature') -> None: ...
+    def update(self, features: Union['Feature', 'Features', Iterable['Feature']]) -> None: ...
+    def __and__(self, other: 'FeatureSet') -> 'FeatureSet': ...
+    def __contains__(self, item: 'Feature') -> bool: ...
+    def __iter__(self) -> Iterator['Feature']: ...
+    def __len__(self) -> int: ...
+    def __or__(self, other: 'FeatureSet') -> 'FeatureSet': ...
+    def __sub__(self, other: 'FeatureSet') -> 'FeatureSet': ...
+    def __xor__(self, other: 'FeatureSet') -> 'FeatureSet': ...
+
 class Formatter:
     id: Union[str, Callable[['Feature'], Union[str,int]]]
     limit: int
@@ -181,16 +238,36 @@ class Map:
     def save(self, filename: str) -> None: ...
     def show(self) -> None: ...
     
+class TagAccessor:
+    @overload
+    def __call__(self, feature: 'Feature') -> Union[str, int, float, bool]: ...
+    @overload
+    def __call__(self, features: 'Features') -> Dict[str, Union['Array', List[str]]]: ...
+
 class Tags:
+    def get(self, key: str, default: Any=None) -> Any: ...
+    def items(self) -> List[Tuple[str, Union[str,int,float]]]: ...
+    def keys(self) -> List[str]: ...
+    def to_dict(self) -> Dict[str, Union[str,int,float]]: ...
+    def values(self) -> List[Union[str,int,float]]: ...
+    def __contains__(self, key: str) -> bool: ...
+    def __getitem__(self, key: str) -> Union[str,int,float,None]: ...
     def __iter__(self) -> Iterator[Tuple[str, Union[str,int,float]]]: ...
+    def __len__(self) -> int: ...
     
 class Tile:
     bounds: 'Box'
+    children: List['Tile']
     column: int
+    features: 'Features'
     id: str
+    is_loaded: bool
+    parent: Optional['Tile']
     revision: int
     row: int
+    shape: Polygon
     size: int
+    tip: int
     zoom: int
 
 @overload
@@ -269,4 +346,10 @@ def length(geom: Geometry | Feature, units:str=...) -> float: ...
 def distance(geom1: Geometry | Feature | Box | Coordinate,
     geom2: Geometry | Feature | Box | Coordinate, units:str=...) -> float: ...
 
-def buffer(geom: Geometry | Feature, distance: float, units : str = 'meters') -> Polygon|MultiPolygon: ...
\ No newline at end of file
+def buffer(geom: Geometry | Feature, distance: float, units : str = 'meters') -> Polygon|MultiPolygon: ...
+
+# Sizes the pool that processes query results (e.g. for Features.area);
+# its threads are only started as jobs need them. Queries themselves run
+# on libgeodesk's own threads, which this doesn't control (the same
+# applies to Features(..., threads=N))
+def set_thread_pool(threads: int, affinity: Optional[Iterable[int]] = None) -> None: ...
@@ -0,0 +1,44 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+# Implementation of Features.parallel_map()
+#
+# The selection is split into the tiles that it touches. Each worker
+# process receives the (pickled) selection and the ID of a tile, opens
+# the GOL (once per process) and applies the function to the features
+# stored in that tile. Every feature belongs to exactly one tile, so no
+# de-duplication is needed. Tiles are handed out largest-first, so the
+# workers finish at roughly the same time.
+
+import multiprocessing
+import os
+
+from ._geodesk import _tile_features
+
+
+def _map_tile(task):
+    features, func, tip, column, row, zoom = task
+    return [func(f) for f in _tile_features(features, tip, column, row, zoom)]
+
+
+def _results(features, func, processes, tiles):
+    if not tiles:
+        return
+    tasks = [(features, func, t.tip, t.column, t.row, t.zoom) for t in tiles]
+    # "spawn" rather than "fork": the parent's query threads
+    # must not be duplicated into the workers
+    context = multiprocessing.get_context("spawn")
+    with context.Pool(min(processes, len(tasks))) as pool:
+        for results in pool.imap_unordered(_map_tile, tasks):
+            yield from results
+
+
+def parallel_map(features, func, processes=None, chunk="tile"):
+    if chunk != "tile":
+        raise ValueError(f"Unsupported chunk: {chunk!r} (must be 'tile')")
+    if processes is None:
+        processes = os.cpu_count() or 1
+    elif processes < 1:
+        raise ValueError("processes must be at least 1")
+    tiles = sorted(features.tiles, key=lambda tile: tile.size, reverse=True)
+    return _results(features, func, processes, tiles)
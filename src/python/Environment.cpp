@@ -7,24 +7,32 @@
 #include <clarisma/util/log.h>
 
 Environment::Environment() :
-    geosContext_(nullptr),
     shapelyModule_(nullptr),
     shapelyApiFunctions_(nullptr),
+    asyncioModule_(nullptr),
+    geodeskModule_(nullptr),
     // emptyFeatures_(nullptr),
     queryException_(nullptr)
 {
     memset(stringConstants_, 0, sizeof(stringConstants_));
 }
 
+/**
+ * Initializes the process-wide state. Called each time a module
+ * instance is initialized, but only the first call has any effect.
+ */
 int Environment::init()
 {
+    if (queryException_) return 0;
     for (int i = 0; i < STRING_CONSTANT_COUNT; i++)
     {
+        if (stringConstants_[i]) continue;
         PyObject* str = PyUnicode_FromString(STRING_CONSTANTS[i]);
         if (str == NULL) return -1;
         stringConstants_[i] = str;
     }
-    return 0;
+    queryException_ = PyErr_NewException("geodesk.QueryError", NULL, NULL);
+    return queryException_ ? 0 : -1;
 }
 
 // keep in order
@@ -40,9 +48,57 @@ const char* Environment::STRING_CONSTANTS[STRING_CONSTANT_COUNT] =
 Environment::~Environment()
 {
     Py_XDECREF(shapelyModule_);
-    if (geosContext_) GEOS_finish_r(geosContext_);
+    Py_XDECREF(asyncioModule_);
+    Py_XDECREF(geodeskModule_);
     // Py_XDECREF(emptyFeatures_);
-    // don't dispose of queryException_, it is tracked by the module itself
+    // Don't dispose of queryException_: the interpreter may already be
+    // gone when the process-wide Environment is destroyed
+}
+
+namespace
+{
+    class ThreadGeosContext
+    {
+    public:
+        ~ThreadGeosContext()
+        {
+            if (context_) GEOS_finish_r(context_);
+        }
+
+        GEOSContextHandle_t get()
+        {
+            if (!context_)
+            {
+                context_ = GEOS_init_r();
+                if (!context_)
+                {
+                    // GEOS_init_r() only fails if it can't allocate
+                    // the context; callers check for nullptr and
+                    // propagate the exception
+                    PyErr_NoMemory();
+                    return nullptr;
+                }
+                GEOSContext_setErrorHandler_r(context_, Environment::reportGeosError);
+            }
+            return context_;
+        }
+
+    private:
+        GEOSContextHandle_t context_ = nullptr;
+    };
+
+    thread_local ThreadGeosContext threadGeosContext;
+}
+
+GEOSContextHandle_t Environment::getGeosContext()
+{
+    return threadGeosContext.get();
+}
+
+PyObject* Environment::importModule(PyObject*& slot, const char* name)
+{
+    if (!slot) slot = PyImport_ImportModule(name);
+    return slot;
 }
 
 /*
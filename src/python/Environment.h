@@ -34,29 +34,35 @@ public:
 
 	static Environment& get() { return ENV; }
 
-	GEOSContextHandle_t getGeosContext()
-	{
-		if (!geosContext_)
-		{
-			geosContext_ = GEOS_init_r();
-			// TODO: handle case if init fails
-			if (!geosContext_)
-			{
-				// TODO: This may not be the proper way to handle this
-				PyErr_SetString(PyExc_RuntimeError, "Failed to initialize GEOS");
-			}
-			GEOSContext_setErrorHandler_r(geosContext_, reportGeosError);
-		}
-		return geosContext_;
-	}
+	/**
+	 * Returns the GEOS context of the calling thread. GEOS is also used
+	 * by threads that don't hold the GIL (the query workers, and code
+	 * that releases the GIL while it measures geometries), and context
+	 * handles must not be shared among threads, so each thread lazily
+	 * creates its own, which is finished when the thread exits.
+	 */
+	GEOSContextHandle_t getGeosContext();
 
 	PyObject* getShapelyModule()
 	{
 		// TODO: Research the liveness guarantee for this pointer;
 		// do we need to hold a reference to the Shapely module?
 
-		if (!shapelyModule_) shapelyModule_ = PyImport_ImportModule("shapely");
-		return shapelyModule_;
+		return importModule(shapelyModule_, "shapely");
+	}
+
+	PyObject* getAsyncioModule()
+	{
+		return importModule(asyncioModule_, "asyncio");
+	}
+
+	/**
+	 * Returns the `geodesk` package (e.g. to look up the functions
+	 * that unpickle features and selections).
+	 */
+	PyObject* getGeodeskModule()
+	{
+		return importModule(geodeskModule_, "geodesk");
 	}
 
 	void** initShapelyFunctions()
@@ -105,24 +111,33 @@ public:
 
 	static void clearAndLogException();
 
+	/**
+	 * Imports a module on first use and keeps a reference to it in
+	 * `slot`. Requires the GIL.
+	 *
+	 * @returns a borrowed reference to the module, or NULL (in which
+	 *   case a Python exception has been raised)
+	 */
+	static PyObject* importModule(PyObject*& slot, const char* name);
+
 	// PyFeatures* getEmptyFeatures();
 	PyObject* raiseQueryException(const char* format, ...);
+	PyObject* queryException() const { return queryException_; }
 
 private:
 	static Environment ENV;
 
-	GEOSContextHandle_t geosContext_;
 	PyObject* shapelyModule_;
 	void** shapelyApiFunctions_;
+	PyObject* asyncioModule_;
+	PyObject* geodeskModule_;
 	// PyFeatures* emptyFeatures_;
-	PyObject* queryException_;		// not owned, don't refcount
+	PyObject* queryException_;		// shared by all module instances
 	// MatcherHolder allMatcher_;
 	// TODO: Decide where to keep this: here of in FeatureStore
 	// (should not be tied to FeatureStore)
 	PyObject* stringConstants_[STRING_CONSTANT_COUNT];
 	static const char* STRING_CONSTANTS[STRING_CONSTANT_COUNT];
-
-	friend PyObject* PyInit__geodesk();
 };
 
 // Don't format string because tuple unpacking relies on exception being raised
@@ -9,6 +9,7 @@
 #include "python/geom/PyBox.h"
 #include "python/geom/PyCoordinate.h"
 #include "python/query/PyFeatures.h"
+#include "python/query/StoreState.h"
 #include "python/util/PyFastMethod.h"
 #include "python/util/PyHash.h"
 
@@ -31,7 +32,7 @@ PyObject* PyAnonymousNode::create(FeatureStore* store, uint64_t id, int32_t x, i
 
 void PyAnonymousNode::dealloc(PyAnonymousNode* self)
 {
-    self->store->release();
+    StoreState::release(self->store);
     Py_TYPE(self)->tp_free(self);
 }
 
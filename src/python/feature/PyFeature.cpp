@@ -8,10 +8,13 @@
 #include "python/geom/PyBox.h"
 #include "python/geom/PyCoordinate.h"
 #include "python/geom/PyMercator.h"
+#include <geodesk/query/TileIndexWalker.h>
 #include "python/query/PyFeatures.h"
+#include "python/query/StoreState.h"
 #include "python/util/PyFastMethod.h"
 #include "python/util/util.h"
 #include "PyTags.h"
+#include "StringObjectCache.h"
 
 #include "PyFeature_lookup.cxx"
 #include "python/util/PyHash.h"
@@ -38,7 +41,7 @@ PyFeature* PyFeature::create(FeatureStore* store, FeaturePtr feature, PyObject*
 void PyFeature::dealloc(PyFeature* self)
 {
     Py_DECREF(self->roleString);
-    self->store->release();
+    StoreState::release(self->store);
     Py_TYPE(self)->tp_free(self);
 }
 
@@ -305,8 +308,18 @@ PyObject* PyFeature::getattr0(PyFeature* self, PyObject* nameObj, const AttrFunc
     {
          return (*table[attr->index])(self);
     }
+    if (name[0] == '_' && name[1] == '_')
+    {
+        // Special attributes (such as __class__ or __reduce_ex__)
+        // rather than tags
+        return PyObject_GenericGetAttr(self, nameObj);
+    }
+    // Attribute names are interned, so the cache can resolve the
+    // key's global-string code by its address
     TagTablePtr tags = self->feature.tags();
-    return tags.getValue(nameObj, self->store->strings());
+    PyObject* value = PyTags::lookup(self->store, tags, nameObj);
+    if (value || PyErr_Occurred()) return value;
+    Py_RETURN_NONE;     // missing tag
 }
 
 PyObject* PyFeature::getBuiltinAttr(PyFeature* self, PyObject* nameObj, const AttrFunctionPtr* const table)
@@ -359,6 +372,127 @@ PyMappingMethods PyFeature::MAPPING_METHODS =
     nullptr          // mp_ass_subscript
 };
 
+/**
+ * Finds the tile in which the given feature is stored, and the offset
+ * of the feature within this tile. The store's state remembers the
+ * locations of the tiles we've looked at, so pickling many features
+ * (which are typically clustered in a few tiles) only walks the tile
+ * index for the first feature of each tile.
+ */
+static bool locateFeature(FeatureStore* store, FeaturePtr feature, Tip* pTip, uint32_t* pOffset)
+{
+    StoreState* state = StoreState::of(store);
+    const uint8_t* p = feature.ptr().ptr();
+    if (state->findTile(p, *pTip, *pOffset))
+    {
+        // Make sure the tile hasn't been mapped elsewhere since
+        TilePtr pTile = store->fetchTile(*pTip);
+        if (pTile && pTile.ptr().ptr() + *pOffset == p) return true;
+    }
+
+    Box bounds = feature.isNode() ? Box(NodePtr(feature).xy()) : feature.bounds();
+    TileIndexWalker tiw(store->tileIndex(), store->zoomLevels(), bounds, nullptr);
+    do
+    {
+        Tip tip = tiw.currentTip();
+        TilePtr pTile = store->fetchTile(tip);
+        if (!pTile) continue;
+        const uint8_t* pStart = pTile.ptr().ptr();
+        state->addTile(tip, pStart, pTile.totalSize());
+        if (p >= pStart && p < pStart + pTile.totalSize())
+        {
+            *pTip = tip;
+            *pOffset = static_cast<uint32_t>(p - pStart);
+            return true;
+        }
+    }
+    while (tiw.next());
+    return false;
+}
+
+PyObject* PyFeature::reduce(PyFeature* self, PyObject* unused)
+{
+    PyObject* restoreFunc = PyObject_GetAttrString(
+        Environment::get().getGeodeskModule(), "_restore_feature");
+    if (!restoreFunc) return NULL;
+
+    Tip tip;
+    uint32_t offset = 0;
+    long tipValue = locateFeature(self->store, self->feature, &tip, &offset) ?
+        (long)tip.value() : -1;
+    const std::string& path = StoreState::of(self->store)->absolutePath();
+    return Py_BuildValue("(N(s#iKlkO))", restoreFunc,
+        path.data(), (Py_ssize_t)path.size(),
+        static_cast<int>(self->feature.type()),
+        (unsigned long long)self->feature.id(),
+        tipValue, (unsigned long)offset, self->roleString);
+}
+
+PyObject* PyFeature::restore(PyObject* module, PyObject* args)
+{
+    PyObject* path;
+    int type;
+    unsigned long long id;
+    long tipValue;
+    unsigned long offset;
+    PyObject* role;
+    if (!PyArg_ParseTuple(args, "UiKlkO", &path, &type, &id, &tipValue, &offset, &role))
+    {
+        return NULL;
+    }
+    if (type < 0 || type > 2)
+    {
+        PyErr_SetString(PyExc_ValueError, "Invalid feature type");
+        return NULL;
+    }
+    PyFeatures* world = PyFeatures::openCached(path);
+    if (!world) return NULL;
+    FeatureStore* store = world->store;
+
+    // If the GOL hasn't changed, the tile and offset lead us
+    // straight to the feature
+    TypedFeatureId typedId = TypedFeatureId::ofTypeAndId(
+        static_cast<FeatureType>(type), id);
+    if (tipValue >= 0)
+    {
+        TilePtr pTile = store->fetchTile(Tip(static_cast<uint32_t>(tipValue)));
+        if (pTile && offset + 8 <= pTile.totalSize())
+        {
+            FeaturePtr feature(pTile.ptr().ptr() + offset);
+            if (feature.typedId() == typedId)
+            {
+                PyObject* result = create(store, feature, role);
+                Py_DECREF(world);
+                return result;
+            }
+        }
+    }
+
+    // Otherwise, we need to search for it
+    PyObject* findArgs = Py_BuildValue("(K)", id);
+    PyObject* result = findArgs ?
+        world->findById(static_cast<FeatureType>(type), findArgs, NULL) : NULL;
+    Py_XDECREF(findArgs);
+    Py_DECREF(world);
+    if (result == Py_None)
+    {
+        Py_DECREF(result);
+        PyErr_Format(PyExc_LookupError, "Feature %llu not found in %U", id, path);
+        return NULL;
+    }
+    if (result && role != Py_None)
+    {
+        Python::set(&((PyFeature*)result)->roleString, role);
+    }
+    return result;
+}
+
+PyMethodDef PyFeature::METHODS[] =
+{
+    { "__reduce__", (PyCFunction)reduce, METH_NOARGS, "Supports pickling" },
+    { NULL, NULL, 0, NULL },
+};
+
 PyTypeObject PyFeature::TYPE =
 {
     .tp_name = "geodesk.Feature",
@@ -374,5 +508,6 @@ PyTypeObject PyFeature::TYPE =
     .tp_doc = "Feature objects",
     .tp_richcompare = (richcmpfunc)richcompare,          
     .tp_iter = (getiterfunc)iter,
+    .tp_methods = METHODS,
 };
 
@@ -21,6 +21,7 @@ public:
     PyObject* roleString;
 
     static PyTypeObject TYPE;
+    static PyMethodDef METHODS[];
     static PyTypeObject* SUBTYPES[];
     static PyMappingMethods MAPPING_METHODS;
     static const AttrFunctionPtr* SUBTYPE_FEATURE_METHODS[];
@@ -33,6 +34,16 @@ public:
     static Py_hash_t hash(PyFeature* self);
     static PyObject* iter(PyFeature* self);
     static PyObject* richcompare(PyFeature* self, PyObject* other, int op);
+    /**
+     * Pickles a feature as the path of its GOL, its type and ID, and 
+     * the tile and offset where it is stored (so the receiving process
+     * can locate it without a search, as long as the GOL is the same).
+     */
+    static PyObject* reduce(PyFeature* self, PyObject* unused);
+    /**
+     * Recreates a pickled feature (module function _restore_feature)
+     */
+    static PyObject* restore(PyObject* module, PyObject* args);
     static int setattr(PyFeature* self, PyObject* name, PyObject* value);
     static PyObject* str(PyFeature* self);
     static PyObject* subscript(PyFeature* self, PyObject* key);
@@ -9,8 +9,10 @@
 #include <geodesk/geom/Length.h>
 #include "python/Environment.h"
 #include "python/format/PyFormatter.h"
+#include "python/geom/GeometryCache.h"
 #include "python/geom/PyCoordinate.h"
 #include "python/query/PyFeatures.h"
+#include "python/query/StoreState.h"
 #include "python/util/util.h"
 
 
@@ -66,8 +68,13 @@ PyObject* PyFeature::Relation::shape(PyFeature* self)
     // TODO: other geometry collections
     */
 
-    return env.buildShapelyGeometry(GeometryBuilder::buildRelationGeometry(
-        self->store, rel, geosContext));
+    // Polygonizing a large area relation is expensive, so the geometry
+    // is taken from the store's cache (Shapely takes ownership, hence
+    // it gets a copy)
+    CachedGeometryRef cached = StoreState::of(self->store)->geometries().get(
+        self->store, rel, geosContext);
+    if (!cached) return NULL;
+    return env.buildShapelyGeometry(GEOSGeom_clone_r(geosContext, cached->geometry()));
 }
 
 AttrFunctionPtr const PyFeature::Relation::FEATURE_METHODS[] =
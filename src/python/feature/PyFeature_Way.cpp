@@ -9,8 +9,10 @@
 #include <geodesk/geom/Mercator.h>
 #include "python/Environment.h"
 #include "python/format/PyFormatter.h"
+#include "python/geom/GeometryCache.h"
 #include "python/geom/PyCoordinate.h"
 #include "python/query/PyFeatures.h"
+#include "python/query/StoreState.h"
 #include "python/util/util.h"
 
 /*
@@ -49,8 +51,11 @@ PyObject* PyFeature::Way::shape(PyFeature* self)
     Environment& env = Environment::get();
     GEOSContextHandle_t geosContext = env.getGeosContext();
     if (!geosContext) return NULL;
-    GEOSGeometry* geom = GeometryBuilder::buildWayGeometry(self->feature, geosContext);
-    return env.buildShapelyGeometry(geom);
+    CachedGeometryRef cached = StoreState::of(self->store)->geometries().get(
+        self->store, self->feature, geosContext);
+    if (!cached) return NULL;
+    // Shapely takes ownership of the geometry, so it gets a copy
+    return env.buildShapelyGeometry(GEOSGeom_clone_r(geosContext, cached->geometry()));
 }
 
 
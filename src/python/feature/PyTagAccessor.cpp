@@ -0,0 +1,327 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "PyTagAccessor.h"
+#include <cmath>
+#include <cstdint>
+#include <new>
+#include <string>
+#include "python/Environment.h"
+#include "python/feature/PyFeature.h"
+#include "python/query/FeatureColumns.h"
+#include "python/query/PyFeatures.h"
+#include "python/query/QueryScan.h"
+#include "python/query/StoreState.h"
+#include "python/util/PyNumArray.h"
+#include "python/util/util.h"
+
+static const char* VALUE_TYPE_NAMES[] = { "str", "int", "float", "bool" };
+
+/// A tag counts as true unless it is missing, empty, "no", "false"
+/// or "0" (or a number equal to 0)
+static bool toBool(const TagReader& reader, TagReader::Value value)
+{
+    if (value.isMissing()) return false;
+    if (value.isString())
+    {
+        std::string_view s = reader.toStringView(value);
+        return !(s.empty() || s == "no" || s == "false" || s == "0");
+    }
+    double d;
+    return reader.toNumber(value, d) && d != 0;
+}
+
+static double toDouble(const TagReader& reader, TagReader::Value value)
+{
+    double d;
+    return reader.toNumber(value, d) ? d : 0;
+}
+
+/// Returns the value as an int64 (for a column of ints); values beyond
+/// the range of int64 are clamped
+static int64_t toInt64(const TagReader& reader, TagReader::Value value)
+{
+    int64_t i;
+    if (reader.toInteger(value, i)) return i;
+    double d = toDouble(reader, value);
+    // 2^63 is exactly representable as a double, INT64_MAX isn't
+    const double LIMIT = 9223372036854775808.0;
+    if (std::isnan(d)) return 0;
+    if (d >= LIMIT) return INT64_MAX;
+    if (d <= -LIMIT) return INT64_MIN;
+    return static_cast<int64_t>(d);
+}
+
+/// Returns the value as a string (the same as Feature.str())
+static PyObject* toStr(const TagReader& reader, StringObjectCache* strings,
+    TagReader::Value value)
+{
+    if (value.isMissing()) return Environment::get().getString(Environment::BLANK);
+    if (value.type == TagReader::GLOBAL_STRING)
+    {
+        return strings->get(TagReader::globalCode(value));
+    }
+    if (value.type == TagReader::LOCAL_STRING)
+    {
+        std::string_view s = reader.toStringView(value);
+        return PyUnicode_FromStringAndSize(s.data(), s.size());
+    }
+    std::string s = TagReader::formatNumber(value);
+    return PyUnicode_FromStringAndSize(s.data(), s.size());
+}
+
+PyObject* PyTagAccessor::create(FeatureStore* store, PyObject* key, PyObject* type)
+{
+    int valueType;
+    if (type == (PyObject*)&PyUnicode_Type)
+    {
+        valueType = STR;
+    }
+    else if (type == (PyObject*)&PyLong_Type)
+    {
+        valueType = INT;
+    }
+    else if (type == (PyObject*)&PyFloat_Type)
+    {
+        valueType = FLOAT;
+    }
+    else if (type == (PyObject*)&PyBool_Type)
+    {
+        valueType = BOOL;
+    }
+    else
+    {
+        PyErr_SetString(PyExc_TypeError, "type must be str, int, float or bool");
+        return NULL;
+    }
+
+    PyTagAccessor* self = (PyTagAccessor*)TYPE.tp_alloc(&TYPE, 0);
+    if (!self) return NULL;
+    new(&self->reader)TagReader();
+    store->addref();
+    self->store = store;
+    self->strings = StringObjectCache::of(store);
+    self->valueType = valueType;
+    Py_INCREF(key);
+    PyUnicode_InternInPlace(&key);
+    self->key = key;
+    if (!self->reader.init(store, key))
+    {
+        Py_DECREF(self);
+        return NULL;
+    }
+    return self;
+}
+
+void PyTagAccessor::dealloc(PyTagAccessor* self)
+{
+    self->reader.~TagReader();
+    Py_XDECREF(self->key);
+    StoreState::release(self->store);
+    Py_TYPE(self)->tp_free(self);
+}
+
+PyObject* PyTagAccessor::valueOf(const TagReader& reader, StringObjectCache* strings,
+    TagTablePtr tags) const
+{
+    TagReader::Value value = reader.get(tags);
+    switch (valueType)
+    {
+    case STR:
+        return toStr(reader, strings, value);
+    case INT:
+    {
+        int64_t i;
+        if (reader.toInteger(value, i)) return PyLong_FromLongLong(i);
+        // Not an integer that fits in 64 bits (or not a number at all,
+        // in which case the value is 0); a Python int has no such limit
+        double d = toDouble(reader, value);
+        if (std::isfinite(d)) return PyLong_FromDouble(d);
+        return PyFloat_FromDouble(d);
+    }
+    case FLOAT:
+        return PyFloat_FromDouble(toDouble(reader, value));
+    default:
+        return Python::boolValue(toBool(reader, value));
+    }
+}
+
+PyObject* PyTagAccessor::columnsOf(PyFeatures* features) const
+{
+    bool world = features->selectionType == &PyFeatures::World::SUBTYPE;
+    if (!world && features->selectionType != &PyFeatures::Empty::SUBTYPE)
+    {
+        PyErr_SetString(PyExc_TypeError,
+            "Accessors can't be applied to selections of related "
+            "features (members, nodes or parents)");
+        return NULL;
+    }
+    if (features->store != store)
+    {
+        PyErr_SetString(PyExc_ValueError,
+            "Accessor and features must belong to the same library");
+        return NULL;
+    }
+
+    static const char VALUE_FORMATS[] = { 0, 'q', 'd', 'B' };
+    if (!world)
+    {
+        FeatureColumns<uint8_t> empty(0);
+        return empty.toDict(valueType == STR ? PyList_New(0) :
+            PyNumArray::create(VALUE_FORMATS[valueType], 0));
+    }
+
+    // The query workers look up the values; for str, they only locate
+    // them, and the strings are created once the query is done
+    QueryScan scan(features);
+    int slots = scan.slotCount();
+    const TagReader& reader = this->reader;
+    if (valueType == STR)
+    {
+        FeatureColumns<TagReader::Value> columns(slots);
+        if (!scan.run([&](int slot, const FeaturePtr* batch, size_t count)
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    columns.add(slot, batch[i], reader.get(batch[i].tags()));
+                }
+            }))
+        {
+            return NULL;
+        }
+        const auto& rows = columns.rows();
+        PyObject* list = PyList_New(rows.size());
+        if (!list) return NULL;
+        for (size_t i = 0; i < rows.size(); i++)
+        {
+            PyObject* str = toStr(reader, strings, rows[i].value);
+            if (!str)
+            {
+                Py_DECREF(list);
+                return NULL;
+            }
+            PyList_SET_ITEM(list, i, str);
+        }
+        return columns.toDict(list);
+    }
+
+    if (valueType == BOOL)
+    {
+        FeatureColumns<uint8_t> columns(slots);
+        if (!scan.run([&](int slot, const FeaturePtr* batch, size_t count)
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    columns.add(slot, batch[i],
+                        toBool(reader, reader.get(batch[i].tags())) ? 1 : 0);
+                }
+            }))
+        {
+            return NULL;
+        }
+        const auto& rows = columns.rows();
+        PyNumArray* values = PyNumArray::create(VALUE_FORMATS[valueType], rows.size());
+        if (!values) return NULL;
+        uint8_t* p = values->values<uint8_t>();
+        for (size_t i = 0; i < rows.size(); i++) p[i] = rows[i].value;
+        return columns.toDict(values);
+    }
+
+    if (valueType == INT)
+    {
+        FeatureColumns<int64_t> columns(slots);
+        if (!scan.run([&](int slot, const FeaturePtr* batch, size_t count)
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    columns.add(slot, batch[i], toInt64(reader, reader.get(batch[i].tags())));
+                }
+            }))
+        {
+            return NULL;
+        }
+        const auto& rows = columns.rows();
+        PyNumArray* values = PyNumArray::create(VALUE_FORMATS[valueType], rows.size());
+        if (!values) return NULL;
+        int64_t* p = values->values<int64_t>();
+        for (size_t i = 0; i < rows.size(); i++) p[i] = rows[i].value;
+        return columns.toDict(values);
+    }
+
+    FeatureColumns<double> columns(slots);
+    if (!scan.run([&](int slot, const FeaturePtr* batch, size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                columns.add(slot, batch[i], toDouble(reader, reader.get(batch[i].tags())));
+            }
+        }))
+    {
+        return NULL;
+    }
+    const auto& rows = columns.rows();
+    PyNumArray* values = PyNumArray::create(VALUE_FORMATS[valueType], rows.size());
+    if (!values) return NULL;
+    double* p = values->values<double>();
+    for (size_t i = 0; i < rows.size(); i++) p[i] = rows[i].value;
+    return columns.toDict(values);
+}
+
+PyObject* PyTagAccessor::call(PyTagAccessor* self, PyObject* args, PyObject* kwargs)
+{
+    PyObject* arg = Python::checkSingleArg(args, kwargs, "Feature or Features");
+    if (!arg) return NULL;
+    PyTypeObject* type = Py_TYPE(arg);
+    if (type == &PyFeature::TYPE)
+    {
+        PyFeature* feature = (PyFeature*)arg;
+        if (feature->store == self->store)
+        {
+            return self->valueOf(self->reader, self->strings, feature->feature.tags());
+        }
+        // A feature from another library: resolve the key against its strings
+        TagReader reader;
+        if (!reader.init(feature->store, self->key)) return NULL;
+        return self->valueOf(reader, StringObjectCache::of(feature->store),
+            feature->feature.tags());
+    }
+    if (type == &PyAnonymousNode::TYPE)
+    {
+        // Anonymous nodes have no tags
+        switch (self->valueType)
+        {
+        case STR:
+            return Environment::get().getString(Environment::BLANK);
+        case INT:
+            return PyLong_FromLong(0);
+        case FLOAT:
+            return PyFloat_FromDouble(0);
+        default:
+            Py_RETURN_FALSE;
+        }
+    }
+    if (type == &PyFeatures::TYPE)
+    {
+        return self->columnsOf((PyFeatures*)arg);
+    }
+    PyErr_Format(PyExc_TypeError, "Expected Feature or Features (instead of %s)",
+        type->tp_name);
+    return NULL;
+}
+
+PyObject* PyTagAccessor::repr(PyTagAccessor* self)
+{
+    return PyUnicode_FromFormat("<accessor %R (%s)>", self->key,
+        VALUE_TYPE_NAMES[self->valueType]);
+}
+
+PyTypeObject PyTagAccessor::TYPE =
+{
+    .tp_name = "geodesk.TagAccessor",
+    .tp_basicsize = sizeof(PyTagAccessor),
+    .tp_dealloc = (destructor)dealloc,
+    .tp_repr = (reprfunc)repr,
+    .tp_call = (ternaryfunc)call,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_DISALLOW_INSTANTIATION,
+    .tp_doc = "Returns the value of a specific tag, converted to a specific type",
+};
@@ -0,0 +1,51 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#pragma once
+
+#include <Python.h>
+#include <geodesk/feature/FeatureStore.h>
+#include "StringObjectCache.h"
+#include "TagReader.h"
+
+using namespace geodesk;
+class PyFeatures;
+
+/// \brief A callable that returns the value of a specific tag, converted
+/// to a specific type (the result of Features.accessor()).
+///
+/// The key is resolved once, when the accessor is created. Applied to a
+/// Feature, the accessor returns the converted value (the type's default
+/// if the feature doesn't have the tag); applied to a Features selection,
+/// it returns the values of all features as columns, which are filled
+/// in by the query workers.
+///
+class PyTagAccessor : public PyObject
+{
+public:
+    enum ValueType
+    {
+        STR,
+        INT,
+        FLOAT,
+        BOOL
+    };
+
+    FeatureStore* store;
+    StringObjectCache* strings;
+    PyObject* key;
+    int valueType;
+    TagReader reader;
+
+    static PyTypeObject TYPE;
+
+    static PyObject* create(FeatureStore* store, PyObject* key, PyObject* type);
+    static void dealloc(PyTagAccessor* self);
+    static PyObject* call(PyTagAccessor* self, PyObject* args, PyObject* kwargs);
+    static PyObject* repr(PyTagAccessor* self);
+
+private:
+    PyObject* valueOf(const TagReader& reader, StringObjectCache* strings,
+        TagTablePtr tags) const;
+    PyObject* columnsOf(PyFeatures* features) const;
+};
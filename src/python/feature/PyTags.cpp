@@ -5,6 +5,7 @@
 #include <geodesk/feature/FeatureStore.h>
 #include <geodesk/feature/TagIterator.h>
 #include <geodesk/format/GeoJsonWriter.h>
+#include "python/query/StoreState.h"
 
 using namespace clarisma;
 
@@ -22,7 +23,7 @@ PyObject* PyTags::create(FeatureStore* store, TagTablePtr tags)
 
 void PyTags::dealloc(PyTags* self)
 {
-    self->store->release();
+    StoreState::release(self->store);
     Py_TYPE(self)->tp_free(self);
 }
 
@@ -48,6 +49,27 @@ Py_ssize_t PyTags::len(PyTags* self)
     return self->tags.count();
 }
 
+PyObject* PyTags::valueOf(FeatureStore* store, StringObjectCache* strings,
+    TagTablePtr tags, TagReader::Value value)
+{
+    if (value.type == TagReader::GLOBAL_STRING)
+    {
+        return strings->get(TagReader::globalCode(value));
+    }
+    return tags.valueAsObject(value.bits, store->strings());
+}
+
+PyObject* PyTags::lookup(FeatureStore* store, TagTablePtr tags, PyObject* keyObj)
+{
+    Py_ssize_t len;
+    const char* key = PyUnicode_AsUTF8AndSize(keyObj, &len);
+    if (!key) return NULL;
+    StringObjectCache* strings = StringObjectCache::of(store);
+    TagReader::Value value = TagReader::lookup(tags, strings->keyCode(keyObj), key, len);
+    if (value.isMissing()) return NULL;
+    return valueOf(store, strings, tags, value);
+}
+
 PyObject* PyTags::subscript(PyTags* self, PyObject* keyObj)
 {
     if (!PyUnicode_Check(keyObj))
@@ -55,7 +77,116 @@ PyObject* PyTags::subscript(PyTags* self, PyObject* keyObj)
         PyErr_SetString(PyExc_TypeError, "Key must be a string");
         return NULL;
     }
-    return self->tags.getValue(keyObj, self->store->strings());
+    PyObject* value = lookup(self->store, self->tags, keyObj);
+    if (value || PyErr_Occurred()) return value;
+    Py_RETURN_NONE;     // missing tag
+}
+
+int PyTags::contains(PyTags* self, PyObject* keyObj)
+{
+    if (!PyUnicode_Check(keyObj)) return 0;
+    Py_ssize_t len;
+    const char* key = PyUnicode_AsUTF8AndSize(keyObj, &len);
+    if (!key) return -1;
+    int keyCode = StringObjectCache::of(self->store)->keyCode(keyObj);
+    return TagReader::lookup(self->tags, keyCode, key, len).isMissing() ? 0 : 1;
+}
+
+PyObject* PyTags::get(PyTags* self, PyObject* args)
+{
+    PyObject* keyObj;
+    PyObject* defaultValue = Py_None;
+    if (!PyArg_ParseTuple(args, "O|O:get", &keyObj, &defaultValue)) return NULL;
+    if (PyUnicode_Check(keyObj))
+    {
+        PyObject* value = lookup(self->store, self->tags, keyObj);
+        if (value || PyErr_Occurred()) return value;
+    }
+    return Python::newRef(defaultValue);
+}
+
+/**
+ * Builds a dict (or a list of keys, values or items) in a single pass
+ * over the tag table. Global keys and global-string values are taken
+ * from the shared string objects.
+ */
+PyObject* PyTags::collect(PyTags* self, Collect what)
+{
+    PyObject* result = what == DICT ? PyDict_New() : PyList_New(0);
+    if (!result) return NULL;
+    FeatureStore* store = self->store;
+    StringObjectCache* strings = StringObjectCache::of(store);
+    TagTablePtr tags = self->tags;
+    bool ok = true;
+    TagReader::forEachTag(tags, store->strings(),
+        [&](std::string_view key, TagReader::Value value)
+        {
+            if (!ok) return;
+            PyObject* keyObj = nullptr;
+            if (what != VALUES)
+            {
+                keyObj = strings->get(key);
+                if (!keyObj)
+                {
+                    ok = false;
+                    return;
+                }
+            }
+            PyObject* valueObj = nullptr;
+            if (what != KEYS)
+            {
+                valueObj = valueOf(store, strings, tags, value);
+                if (!valueObj)
+                {
+                    Py_XDECREF(keyObj);
+                    ok = false;
+                    return;
+                }
+            }
+            switch (what)
+            {
+            case DICT:
+                ok = PyDict_SetItem(result, keyObj, valueObj) == 0;
+                break;
+            case KEYS:
+                ok = PyList_Append(result, keyObj) == 0;
+                break;
+            case VALUES:
+                ok = PyList_Append(result, valueObj) == 0;
+                break;
+            case ITEMS:
+            {
+                PyObject* item = PyTuple_Pack(2, keyObj, valueObj);
+                ok = item && PyList_Append(result, item) == 0;
+                Py_XDECREF(item);
+                break;
+            }
+            }
+            Py_XDECREF(keyObj);
+            Py_XDECREF(valueObj);
+        });
+    if (!ok) Py_CLEAR(result);
+    return result;
+}
+
+PyObject* PyTags::to_dict(PyTags* self, PyObject* unused)
+{
+    return collect(self, DICT);
+}
+
+PyObject* PyTags::keys(PyTags* self, PyObject* unused)
+{
+    return collect(self, KEYS);
+}
+
+PyObject* PyTags::values(PyTags* self, PyObject* unused)
+{
+    return collect(self, VALUES);
+}
+
+PyObject* PyTags::items(PyTags* self, PyObject* unused)
+{
+    return collect(self, ITEMS);
 }
 
 PyMappingMethods PyTags::MAPPING_METHODS =
@@ -65,23 +196,41 @@ PyMappingMethods PyTags::MAPPING_METHODS =
     nullptr          // mp_ass_subscript
 };
 
+PySequenceMethods PyTags::SEQUENCE_METHODS =
+{
+    .sq_contains = (objobjproc)contains,
+};
+
+PyMethodDef PyTags::METHODS[] =
+{
+    { "get", (PyCFunction)get, METH_VARARGS,
+      "Returns the value of the given key, or the default if the tag is missing" },
+    { "items", (PyCFunction)items, METH_NOARGS, "Returns a list of (key, value) tuples" },
+    { "keys", (PyCFunction)keys, METH_NOARGS, "Returns a list of the keys" },
+    { "to_dict", (PyCFunction)to_dict, METH_NOARGS, "Returns the tags as a dict" },
+    { "values", (PyCFunction)values, METH_NOARGS, "Returns a list of the values" },
+    { nullptr, nullptr, 0, nullptr }
+};
+
 PyTypeObject PyTags::TYPE =
 {
     .tp_name = "geodesk.Tags",
     .tp_basicsize = sizeof(PyTags),
     .tp_dealloc = (destructor)dealloc,
     .tp_repr = (reprfunc)str,
+    .tp_as_sequence = &SEQUENCE_METHODS,
     .tp_as_mapping = &MAPPING_METHODS,
     // tp_hash 
     .tp_str = (reprfunc)str,
     .tp_flags = Py_TPFLAGS_DEFAULT, // | Py_TPFLAGS_DISALLOW_INSTANTIATION,
     .tp_iter = (getiterfunc)iter,
+    .tp_methods = METHODS,
 };
 
 
 void PyTagIterator::dealloc(PyTagIterator* self)
 {
-    self->store->release();
+    StoreState::release(self->store);
     Py_TYPE(self)->tp_free(self);
 }
 
@@ -94,7 +243,11 @@ void PyTagIterator::dealloc(PyTagIterator* self)
 PyObject* PyTagIterator::createTag(PyTagIterator* self, PyObject* key, uint64_t tagVal)
 {
     if (!key) return NULL;
-    PyObject* value = self->tags.valueAsObject(tagVal, self->store->strings());
+    // Global-string values (type 1) are taken from the string cache;
+    // their code is in Bits 16-31 for both global and local keys
+    PyObject* value = (tagVal & 3) == 1 ?
+        self->strings->get(static_cast<int>((tagVal >> 16) & 0xffff)) :
+        self->tags.valueAsObject(tagVal, self->store->strings());
     if (!value)
     {
         Py_DECREF(key);
@@ -141,7 +294,7 @@ PyObject* PyTagIterator::nextGlobal(PyTagIterator* self)
     self->func = NEXT[((tag >> 14) & 2) + self->tags.hasLocalKeys()];
 
     int keyCode = (tag >> 2) & 0x1fff;
-    PyObject* keyObj = self->store->strings().getStringObject(keyCode);
+    PyObject* keyObj = self->strings->get(keyCode);
     return createTag(self, keyObj, tagVal);
 }
 
@@ -196,6 +349,7 @@ PyObject* PyTagIterator::create(FeatureStore* store, TagTablePtr tags)
         store->addref();
         self->store = store;
         self->tags = tags;
+        self->strings = StringObjectCache::of(store);
         DataPtr p = tags.ptr();
         self->current = p;
         if (p.getUnsignedInt() != TagValues::EMPTY_TABLE_MARKER)
@@ -5,6 +5,8 @@
 
 #include <Python.h>
 #include <geodesk/feature/FeaturePtr.h>
+#include "StringObjectCache.h"
+#include "TagReader.h"
 
 using namespace geodesk;
 
@@ -17,6 +19,8 @@ public:
 
     static PyTypeObject TYPE;
     static PyMappingMethods MAPPING_METHODS;
+    static PySequenceMethods SEQUENCE_METHODS;
+    static PyMethodDef METHODS[];
 
     static PyObject* create(FeatureStore* store, TagTablePtr tags);
     static void dealloc(PyTags* self);
@@ -24,6 +28,25 @@ public:
     static PyObject* str(PyTags* self);
     static PyObject* iter(PyTags* self);
     static PyObject* subscript(PyTags* self, PyObject* keyObj);
+    static int contains(PyTags* self, PyObject* keyObj);
+    static PyObject* get(PyTags* self, PyObject* args);
+    static PyObject* to_dict(PyTags* self, PyObject* unused);
+    static PyObject* keys(PyTags* self, PyObject* unused);
+    static PyObject* values(PyTags* self, PyObject* unused);
+    static PyObject* items(PyTags* self, PyObject* unused);
+
+    /// Returns a new reference to the value of the tag with the given
+    /// key (which must be a str), or NULL if the tag is missing (NULL
+    /// with a Python exception set if an error occurred)
+    static PyObject* lookup(FeatureStore* store, TagTablePtr tags, PyObject* keyObj);
+
+    /// Returns a new reference to the object that represents the value
+    static PyObject* valueOf(FeatureStore* store, StringObjectCache* strings,
+        TagTablePtr tags, TagReader::Value value);
+
+private:
+    enum Collect { DICT, KEYS, VALUES, ITEMS };
+    static PyObject* collect(PyTags* self, Collect what);
 };
 
 
@@ -37,6 +60,7 @@ public:
     TagTablePtr tags;
     DataPtr current;
     NextTagFunc func;
+    StringObjectCache* strings;
 
     static PyTypeObject TYPE;
 
@@ -0,0 +1,140 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "StringObjectCache.h"
+#include "python/query/StoreState.h"
+
+StringObjectCache::StringObjectCache(FeatureStore* store) :
+    strings_(&store->strings()),
+    objects_(store->strings().stringCount(), nullptr)
+{
+}
+
+StringObjectCache* StringObjectCache::of(FeatureStore* store)
+{
+    return &StoreState::of(store)->strings();
+}
+
+void StringObjectCache::clear()
+{
+    Python::MutexLock lock(mutex_);
+    for (PyObject*& obj : objects_) Py_CLEAR(obj);
+    clearKeyCodes();
+}
+
+void StringObjectCache::clearKeyCodes()
+{
+    for (const auto& [key, code] : keyCodes_) Py_DECREF(key);
+    keyCodes_.clear();
+    localKeys_.clear();
+}
+
+PyObject* StringObjectCache::get(int code)
+{
+    Python::MutexLock lock(mutex_);
+    PyObject*& slot = objects_[code];
+    if (!slot)
+    {
+        const ShortVarString* s = strings_->getGlobalString(code);
+        PyObject* obj = PyUnicode_FromStringAndSize(s->data(), s->length());
+        if (!obj) return NULL;
+        PyUnicode_InternInPlace(&obj);
+        slot = obj;
+    }
+    Py_INCREF(slot);
+    return slot;
+}
+
+PyObject* StringObjectCache::get(std::string_view s)
+{
+    int code = strings_->getCode(s.data(), s.size());
+    if (code < 0) return Python::toStringObject(s.data(), s.size());
+    return get(code);
+}
+
+int StringObjectCache::keyCode(PyObject* key)
+{
+    // Only the codes of keys 0 - 8191 are used for global keys
+    const int MAX_GLOBAL_KEY_CODE = 0x1fff;
+
+    if (!PyUnicode_CHECK_INTERNED(key))
+    {
+        int code = strings_->getCode(key);
+        return code <= MAX_GLOBAL_KEY_CODE ? code : -1;
+    }
+    Python::MutexLock lock(mutex_);
+    auto it = keyCodes_.find(key);
+    if (it != keyCodes_.end()) return it->second;
+    int code = strings_->getCode(key);
+    if (code > MAX_GLOBAL_KEY_CODE) code = -1;
+    if (code < 0)
+    {
+        if (localKeys_.size() >= MAX_LOCAL_KEY_CODES)
+        {
+            PyObject* oldest = localKeys_.front();
+            localKeys_.pop_front();
+            keyCodes_.erase(oldest);
+            Py_DECREF(oldest);
+        }
+        localKeys_.push_back(key);
+    }
+    Py_INCREF(key);
+    keyCodes_.emplace(key, code);
+    return code;
+}
+
+
+PyObject* PyStringTable::create(FeatureStore* store)
+{
+    PyStringTable* self = (PyStringTable*)TYPE.tp_alloc(&TYPE, 0);
+    if (self)
+    {
+        store->addref();
+        self->store = store;
+        self->cache = StringObjectCache::of(store);
+    }
+    return self;
+}
+
+void PyStringTable::dealloc(PyStringTable* self)
+{
+    StoreState::release(self->store);
+    Py_TYPE(self)->tp_free(self);
+}
+
+Py_ssize_t PyStringTable::len(PyStringTable* self)
+{
+    return self->cache->size();
+}
+
+PyObject* PyStringTable::item(PyStringTable* self, Py_ssize_t index)
+{
+    if (index < 0 || index >= self->cache->size())
+    {
+        PyErr_SetString(PyExc_IndexError, "Index out of range");
+        return NULL;
+    }
+    return self->cache->get(static_cast<int>(index));
+}
+
+PyObject* PyStringTable::repr(PyStringTable* self)
+{
+    return PyUnicode_FromFormat("<StringTable with %u strings>", self->cache->size());
+}
+
+PySequenceMethods PyStringTable::SEQUENCE_METHODS =
+{
+    .sq_length = (lenfunc)len,
+    .sq_item = (ssizeargfunc)item,
+};
+
+PyTypeObject PyStringTable::TYPE =
+{
+    .tp_name = "geodesk.StringTable",
+    .tp_basicsize = sizeof(PyStringTable),
+    .tp_dealloc = (destructor)dealloc,
+    .tp_repr = (reprfunc)repr,
+    .tp_as_sequence = &SEQUENCE_METHODS,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_DISALLOW_INSTANTIATION,
+    .tp_doc = "The global strings of a feature library",
+};
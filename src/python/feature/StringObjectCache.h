@@ -0,0 +1,93 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#pragma once
+
+#include <Python.h>
+#include <deque>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <geodesk/feature/FeaturePtr.h>
+#include <geodesk/feature/FeatureStore.h>
+#include "python/util/util.h"
+
+using namespace geodesk;
+
+/// \brief Interned string objects for the global strings of a
+/// FeatureStore, indexed by string code.
+///
+/// Keys, values and roles are overwhelmingly drawn from the global
+/// string table, so rather than creating a new str for every tag we
+/// hand out the same (interned) objects, which also have their hash
+/// values cached when used as dict keys. The objects are created on
+/// first use; each store's cache belongs to its StoreState, which
+/// releases the objects once the store has been released, or when
+/// the module is freed.
+///
+/// All methods require the GIL.
+///
+class StringObjectCache
+{
+public:
+    explicit StringObjectCache(FeatureStore* store);
+
+    /// Returns the cache of the given store
+    static StringObjectCache* of(FeatureStore* store);
+
+    /// Returns a new reference to the string with the given
+    /// global-string code (or NULL if the object couldn't be created)
+    PyObject* get(int code);
+
+    /// Returns a new reference to the cached string object if `s` is
+    /// a global string, otherwise to a new str (or NULL on failure)
+    PyObject* get(std::string_view s);
+
+    /// Returns the global-string code of a key (or -1 if it can only
+    /// be a local key). The codes of interned strings (such as attribute
+    /// names) are remembered, so looking them up again is cheap.
+    int keyCode(PyObject* key);
+
+    uint32_t size() const { return static_cast<uint32_t>(objects_.size()); }
+
+    /// Releases the cached string objects (they are created anew if
+    /// they are needed again)
+    void clear();
+
+private:
+    void clearKeyCodes();
+
+    /// Upper limit for the number of remembered keys that aren't global
+    /// keys (once reached, the oldest is forgotten); the number of global
+    /// keys is bounded by the size of the string table
+    static const size_t MAX_LOCAL_KEY_CODES = 1024;
+
+    StringTable* strings_;
+    std::vector<PyObject*> objects_;
+    /// Key codes by (interned) key object; the keys are strong references,
+    /// so their addresses can't be reused for other strings
+    std::unordered_map<PyObject*,int> keyCodes_;
+    /// The remembered keys that aren't global keys, oldest first
+    std::deque<PyObject*> localKeys_;
+    Python::Mutex mutex_;
+};
+
+
+/// \brief The global strings of a FeatureStore as a lazy, read-only
+/// sequence (the result of Features.strings).
+///
+class PyStringTable : public PyObject
+{
+public:
+    FeatureStore* store;
+    StringObjectCache* cache;
+
+    static PyTypeObject TYPE;
+    static PySequenceMethods SEQUENCE_METHODS;
+
+    static PyObject* create(FeatureStore* store);
+    static void dealloc(PyStringTable* self);
+    static Py_ssize_t len(PyStringTable* self);
+    static PyObject* item(PyStringTable* self, Py_ssize_t index);
+    static PyObject* repr(PyStringTable* self);
+};
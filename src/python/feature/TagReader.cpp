@@ -0,0 +1,176 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "TagReader.h"
+#include <cmath>
+#include <cstdio>
+#include <clarisma/math/Math.h>
+
+using namespace clarisma;
+
+// Tags are looked up (and iterated) by libgeodesk, which returns the
+// value as TagBits: the value type in Bits 0-1, a narrow value in
+// Bits 16-31, and the offset of a wide value (relative to the tag-table
+// pointer) in the upper 32 bits.
+//
+// Numbers are stored with an offset of MIN_NUMBER; wide numbers are
+// decimals with a 30-bit mantissa and a 2-bit scale. Strings are
+// converted to numbers by the same parser as Feature.num().
+
+static const int MIN_NUMBER = -256;
+static const int MAX_GLOBAL_KEY_CODE = 0x1fff;
+
+bool TagReader::init(FeatureStore* store, PyObject* keyObj)
+{
+    if (!PyUnicode_Check(keyObj))
+    {
+        PyErr_SetString(PyExc_TypeError, "Key must be a string");
+        return false;
+    }
+    Py_ssize_t len;
+    const char* s = PyUnicode_AsUTF8AndSize(keyObj, &len);
+    if (!s) return false;
+    strings_ = &store->strings();
+    key_.assign(s, len);
+    int code = strings_->getCode(s, len);
+    keyCode_ = (code >= 0 && code <= MAX_GLOBAL_KEY_CODE) ? code : -1;
+    return true;
+}
+
+TagReader::Value TagReader::lookup(TagTablePtr tags, int keyCode, const char* key, size_t len)
+{
+    if (keyCode >= 0)
+    {
+        TagBits bits = tags.getGlobalKeyValue(keyCode);
+        if (bits) return fromBits(tags, bits);
+    }
+    if (!tags.hasLocalKeys()) return { MISSING };
+    return fromBits(tags, tags.getLocalKeyValue(std::string_view(key, len)));
+}
+
+static const double POWERS_OF_TEN[] = { 1, 10, 100, 1000 };
+
+bool TagReader::toNumber(Value value, double& result) const
+{
+    switch (value.type)
+    {
+    case NARROW_NUMBER:
+        result = static_cast<int>(value.narrow()) + MIN_NUMBER;
+        return true;
+    case WIDE_NUMBER:
+    {
+        uint32_t raw = value.p.getUnsignedIntUnaligned();
+        int64_t mantissa = static_cast<int64_t>(raw >> 2) + MIN_NUMBER;
+        result = mantissa / POWERS_OF_TEN[raw & 3];
+        return true;
+    }
+    case GLOBAL_STRING:
+    case LOCAL_STRING:
+        return Math::parseDouble(toStringView(value), &result);
+    default:
+        return false;
+    }
+}
+
+bool TagReader::toInteger(Value value, int64_t& result) const
+{
+    switch (value.type)
+    {
+    case NARROW_NUMBER:
+        result = static_cast<int>(value.narrow()) + MIN_NUMBER;
+        return true;
+    case WIDE_NUMBER:
+    {
+        uint32_t raw = value.p.getUnsignedIntUnaligned();
+        int64_t mantissa = static_cast<int64_t>(raw >> 2) + MIN_NUMBER;
+        // Integer division truncates towards zero, as int() does
+        result = mantissa / static_cast<int64_t>(POWERS_OF_TEN[raw & 3]);
+        return true;
+    }
+    case GLOBAL_STRING:
+    case LOCAL_STRING:
+    {
+        // Only take the integer if it is what Feature.num() reads from
+        // the string (which may also accept exponents, for example);
+        // otherwise, the caller goes through toNumber()
+        std::string_view s = toStringView(value);
+        double d;
+        return Math::parseDouble(s, &d) && parseInteger(s, result) &&
+            static_cast<double>(result) == std::trunc(d);
+    }
+    default:
+        return false;
+    }
+}
+
+std::string_view TagReader::toStringView(Value value) const
+{
+    const ShortVarString* s;
+    if (value.type == GLOBAL_STRING)
+    {
+        s = strings_->getGlobalString(static_cast<int>(value.narrow()));
+    }
+    else if (value.type == LOCAL_STRING)
+    {
+        // Local strings are addressed relative to the value itself
+        s = reinterpret_cast<const ShortVarString*>(
+            value.p.ptr() + value.p.getIntUnaligned());
+    }
+    else
+    {
+        return std::string_view();
+    }
+    return s->toStringView();
+}
+
+std::string TagReader::formatNumber(int type, uint32_t raw)
+{
+    char buf[32];
+    if (type == NARROW_NUMBER)
+    {
+        snprintf(buf, sizeof(buf), "%d", static_cast<int>(raw) + MIN_NUMBER);
+    }
+    else
+    {
+        int64_t mantissa = static_cast<int64_t>(raw >> 2) + MIN_NUMBER;
+        int scale = raw & 3;
+        if (scale == 0)
+        {
+            snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(mantissa));
+        }
+        else
+        {
+            int64_t divisor = static_cast<int64_t>(POWERS_OF_TEN[scale]);
+            int64_t absMantissa = mantissa < 0 ? -mantissa : mantissa;
+            snprintf(buf, sizeof(buf), "%s%lld.%0*lld", mantissa < 0 ? "-" : "",
+                static_cast<long long>(absMantissa / divisor), scale,
+                static_cast<long long>(absMantissa % divisor));
+        }
+    }
+    return std::string(buf);
+}
+
+bool TagReader::parseInteger(std::string_view s, int64_t& result)
+{
+    size_t i = 0;
+    size_t len = s.size();
+    while (i < len && (s[i] == ' ' || s[i] == '\t')) i++;
+    bool negative = false;
+    if (i < len && (s[i] == '-' || s[i] == '+'))
+    {
+        negative = s[i] == '-';
+        i++;
+    }
+    if (i == len || s[i] < '0' || s[i] > '9') return false;
+    // The magnitude of INT64_MIN is one more than INT64_MAX
+    uint64_t limit = static_cast<uint64_t>(INT64_MAX) + (negative ? 1 : 0);
+    uint64_t v = 0;
+    while (i < len && s[i] >= '0' && s[i] <= '9')
+    {
+        uint64_t digit = s[i++] - '0';
+        if (v > (limit - digit) / 10) return false;
+        v = v * 10 + digit;
+    }
+    result = negative ? static_cast<int64_t>(0 - v) : static_cast<int64_t>(v);
+    return true;
+}
@@ -0,0 +1,135 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#pragma once
+
+#include <Python.h>
+#include <string>
+#include <string_view>
+#include <geodesk/feature/FeaturePtr.h>
+#include <geodesk/feature/FeatureStore.h>
+#include <geodesk/feature/TagIterator.h>
+
+using namespace geodesk;
+
+/// \brief Looks up the value of a specific key in tag tables, without
+/// creating Python objects (and hence without needing the GIL).
+///
+/// The key is resolved against the store's string table once (this
+/// step needs the GIL); afterwards, the reader can be used by any number
+/// of threads at the same time. Used by aggregations such as
+/// Features.top() that run on the query workers.
+///
+class TagReader
+{
+public:
+    /// Value types, as encoded in the lower two bits of a tag
+    enum ValueType
+    {
+        NARROW_NUMBER = 0,
+        GLOBAL_STRING = 1,
+        WIDE_NUMBER = 2,
+        LOCAL_STRING = 3,
+        MISSING = -1
+    };
+
+    struct Value
+    {
+        int type;
+        DataPtr p;      // location of a wide value (undefined for
+                        // narrow values, which are held by `bits`)
+        TagBits bits;   // the value as returned by TagTablePtr's lookup
+                        // (as accepted by TagTablePtr::valueAsObject())
+
+        bool isMissing() const { return type < 0; }
+        bool isString() const { return type & 1; }
+        bool isWide() const { return type & 2; }
+        uint32_t narrow() const { return static_cast<uint16_t>(bits >> 16); }
+    };
+
+    /// Turns the TagBits returned by libgeodesk's lookups and
+    /// TagIterator into a Value (0 means the tag is missing)
+    static Value fromBits(TagTablePtr tags, TagBits bits)
+    {
+        if (!bits) return { MISSING };
+        return { static_cast<int>(bits & 3),
+            tags.ptr() + static_cast<int32_t>(bits >> 32), bits };
+    }
+
+    /// Resolves the key (a str object); returns false (with a
+    /// Python exception set) if `keyObj` isn't a str
+    bool init(FeatureStore* store, PyObject* keyObj);
+
+    const std::string& key() const { return key_; }
+
+    /// Returns the value of the key in the given tag table
+    Value get(TagTablePtr tags) const
+    {
+        return lookup(tags, keyCode_, key_.data(), key_.size());
+    }
+
+    /// Returns the value of a key, given its text and its global-string
+    /// code (or -1 if it can only be a local key)
+    static Value lookup(TagTablePtr tags, int keyCode, const char* key, size_t len);
+
+    /// Converts the value to a number, using the same parser as
+    /// Feature.num(). Returns false if the key is missing, or its
+    /// value is a string that isn't a number.
+    bool toNumber(Value value, double& result) const;
+
+    /// Converts the value to an integer without going through a double,
+    /// truncating any fraction (the same as int(Feature.num())). Returns
+    /// false if the key is missing, its value isn't a number, or doesn't
+    /// fit in 64 bits; in this case, callers fall back to toNumber().
+    bool toInteger(Value value, int64_t& result) const;
+
+    /// Returns the global-string code of a string value (or -1 if
+    /// the value isn't a global string)
+    static int globalCode(Value value)
+    {
+        return value.type == GLOBAL_STRING ? static_cast<int>(value.narrow()) : -1;
+    }
+
+    /// Returns the text of a string value (empty if the value is a number)
+    std::string_view toStringView(Value value) const;
+
+    /// Returns the raw (encoded) form of a number value
+    static uint32_t rawNumber(Value value)
+    {
+        return value.type == WIDE_NUMBER ? value.p.getUnsignedIntUnaligned() :
+            value.narrow();
+    }
+
+    /// Formats a number value the same way as Feature.str()
+    static std::string formatNumber(Value value)
+    {
+        return formatNumber(value.type, rawNumber(value));
+    }
+
+    /// Formats a number value, given its type and raw form
+    static std::string formatNumber(int type, uint32_t raw);
+
+    /// Parses the integer at the start of a string (optional sign and
+    /// digits); returns false if the string doesn't start with a digit
+    /// (after the sign) or the integer doesn't fit in 64 bits
+    static bool parseInteger(std::string_view s, int64_t& result);
+
+    /// Calls `fn(std::string_view key, Value value)` for each tag,
+    /// in the order of libgeodesk's TagIterator
+    template<typename Fn>
+    static void forEachTag(TagTablePtr tags, StringTable& strings, Fn fn)
+    {
+        TagIterator iter(tags, strings);
+        std::string_view key;
+        TagBits bits;
+        while (iter.next(key, bits))
+        {
+            fn(key, fromBits(tags, bits));
+        }
+    }
+
+private:
+    StringTable* strings_ = nullptr;
+    int keyCode_ = -1;      // -1 if the key can only be a local key
+    std::string key_;
+};
@@ -0,0 +1,69 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "IdBitmap.h"
+#include <algorithm>
+
+IdBitmap::IdBitmap(std::vector<uint64_t>& ids) :
+    count_(0),
+    useIndex_(false)
+{
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    count_ = ids.size();
+
+    size_t i = 0;
+    while (i < ids.size())
+    {
+        uint64_t key = ids[i] >> 16;
+        size_t end = i + 1;
+        while (end < ids.size() && (ids[end] >> 16) == key) end++;
+        uint32_t size = static_cast<uint32_t>(end - i);
+        if (size > MAX_ARRAY_SIZE)
+        {
+            uint32_t offset = static_cast<uint32_t>(words_.size());
+            words_.resize(words_.size() + WORDS_PER_BITMAP);
+            uint64_t* words = &words_[offset];
+            for (size_t j = i; j < end; j++)
+            {
+                uint32_t low = static_cast<uint32_t>(ids[j] & 0xffff);
+                words[low >> 6] |= 1ULL << (low & 63);
+            }
+            containers_.push_back({ key, offset, size, true });
+        }
+        else
+        {
+            uint32_t offset = static_cast<uint32_t>(values_.size());
+            for (size_t j = i; j < end; j++)
+            {
+                values_.push_back(static_cast<uint16_t>(ids[j] & 0xffff));
+            }
+            containers_.push_back({ key, offset, size, false });
+        }
+        i = end;
+    }
+
+    if (!containers_.empty() && containers_.back().key <= MAX_INDEXED_KEY)
+    {
+        useIndex_ = true;
+        index_.assign(containers_.back().key + 1, -1);
+        for (size_t n = 0; n < containers_.size(); n++)
+        {
+            index_[containers_[n].key] = static_cast<int32_t>(n);
+        }
+    }
+}
+
+const IdBitmap::Container* IdBitmap::findContainer(uint64_t key) const
+{
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+        [](const Container& c, uint64_t k) { return c.key < k; });
+    return (it != containers_.end() && it->key == key) ? &*it : nullptr;
+}
+
+bool IdBitmap::containsValue(const Container* container, uint16_t value) const
+{
+    const uint16_t* start = values_.data() + container->offset;
+    const uint16_t* end = start + container->size;
+    return std::binary_search(start, end, value);
+}
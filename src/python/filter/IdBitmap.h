@@ -0,0 +1,85 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// \brief An immutable, compressed set of 64-bit IDs, organized like a
+/// Roaring bitmap.
+///
+/// IDs are grouped by their upper 48 bits into containers that hold
+/// the lower 16 bits of up to 65536 IDs: a sorted array of 16-bit
+/// values if the container has at most 4096 IDs, otherwise a bitmap
+/// of 8 KB. Both take at most 2 bytes per ID, and a densely populated
+/// ID range (such as the IDs of recently edited features) takes
+/// as little as 1 bit per ID.
+///
+/// The containers are located via a table indexed by the upper bits
+/// (if it isn't unreasonably large, which it never is for OSM IDs),
+/// so contains() takes constant time for bitmap containers, and a
+/// binary search over no more than 4096 values for array containers.
+///
+/// Once built, an IdBitmap can be read by multiple threads.
+///
+class IdBitmap
+{
+public:
+    /// Builds the bitmap from the given IDs, which may be in any order
+    /// and contain duplicates (the vector is sorted in the process)
+    explicit IdBitmap(std::vector<uint64_t>& ids);
+
+    bool contains(uint64_t id) const
+    {
+        uint64_t key = id >> 16;
+        const Container* container;
+        if (useIndex_)
+        {
+            if (key >= index_.size()) return false;
+            int32_t n = index_[key];
+            if (n < 0) return false;
+            container = &containers_[n];
+        }
+        else
+        {
+            container = findContainer(key);
+            if (!container) return false;
+        }
+        uint32_t low = static_cast<uint32_t>(id & 0xffff);
+        if (container->isBitmap)
+        {
+            return (words_[container->offset + (low >> 6)] >> (low & 63)) & 1;
+        }
+        return containsValue(container, static_cast<uint16_t>(low));
+    }
+
+    bool isEmpty() const { return count_ == 0; }
+    size_t count() const { return count_; }
+
+private:
+    struct Container
+    {
+        uint64_t key;
+        uint32_t offset;    // into words_ or values_
+        uint32_t size;      // number of IDs
+        bool isBitmap;
+    };
+
+    static const uint32_t MAX_ARRAY_SIZE = 4096;
+    static const uint32_t WORDS_PER_BITMAP = 1024;
+    /// Largest key for which we create a direct index (the index takes
+    /// 4 bytes per key; OSM IDs, even at 2^34, only need keys up to 2^18)
+    static const uint64_t MAX_INDEXED_KEY = (1 << 22) - 1;
+
+    const Container* findContainer(uint64_t key) const;
+    bool containsValue(const Container* container, uint16_t value) const;
+
+    std::vector<Container> containers_;     // sorted by key
+    std::vector<int32_t> index_;            // container number by key (or -1)
+    std::vector<uint64_t> words_;           // bits of the bitmap containers
+    std::vector<uint16_t> values_;          // values of the array containers
+    size_t count_;
+    bool useIndex_;
+};
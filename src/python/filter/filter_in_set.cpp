@@ -0,0 +1,27 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "filters.h"
+#include "python/query/PyFeatureSet.h"
+#include "python/util/util.h"
+
+
+PyFeatures* filters::in_set(PyFeatures* self, PyObject* args, PyObject* kwargs)
+{
+	PyObject* arg = Python::checkSingleArg(args, kwargs, &PyFeatureSet::TYPE);
+	if (!arg) return NULL;
+	PyFeatureSet* set = (PyFeatureSet*)arg;
+
+	// The filter takes a snapshot of the set, so changes to the set
+	// don't affect selections that have already been created; its
+	// bounds are those of the set's features, which withFilter()
+	// applies to the selection
+	const Filter* filter;
+	{
+		Python::CriticalSection lock(set);
+		filter = set->createFilter(self->store,
+			(self->flags & SelectionFlags::USES_BOUNDS) ? self->bounds : Box::ofWorld());
+	}
+	if (!filter) return self->getEmpty();
+	return self->withFilter(filter);
+}
@@ -0,0 +1,350 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "filters.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_set>
+#include <vector>
+#include <geodesk/filter/ComboFilter.h>
+#include <geodesk/geom/Mercator.h>
+#include <geodesk/geom/SpatialUnit.h>
+#include <geodesk/query/Query.h>
+#include <geodesk/query/TileIndexWalker.h>
+#include "python/Environment.h"
+#include "python/feature/PyFeature.h"
+#include "python/geom/DistanceMeasurer.h"
+#include "python/geom/PyMercator.h"
+#include "python/geom/ShapeHolder.h"
+#include "python/query/TileFilter.h"
+#include "python/util/util.h"
+
+
+namespace {
+
+/// Distances are measured along the sphere, which can be slightly
+/// shorter than the Mercator distance scaled at the nearest point,
+/// so we shave a little off our lower bounds to keep them safe
+const double LOWER_BOUND_FACTOR = 0.99;
+
+/// Initial distance (in Mercator units, about 600 meters at the
+/// equator) by which the tile search reaches beyond the target
+const int64_t INITIAL_MARGIN = 1 << 16;
+
+int32_t clampToInt32(int64_t v)
+{
+	return static_cast<int32_t>(std::clamp(v,
+		static_cast<int64_t>(std::numeric_limits<int32_t>::min()),
+		static_cast<int64_t>(std::numeric_limits<int32_t>::max())));
+}
+
+/// Returns the Mercator y of the two boxes that lies farthest from the
+/// equator (where a Mercator unit represents the fewest meters)
+int32_t farthestY(const Box& a, const Box& b)
+{
+	int32_t y = 0;
+	for (int32_t v : { a.minY(), a.maxY(), b.minY(), b.maxY() })
+	{
+		if (std::abs(static_cast<int64_t>(v)) > std::abs(static_cast<int64_t>(y))) y = v;
+	}
+	return y;
+}
+
+/// Returns a lower bound for the distance (in meters) between anything
+/// that lies in box `a` and anything that lies in box `b`
+double lowerBound(const Box& a, const Box& b)
+{
+	double dx = std::max({ 0.0,
+		static_cast<double>(a.minX()) - b.maxX(),
+		static_cast<double>(b.minX()) - a.maxX() });
+	double dy = std::max({ 0.0,
+		static_cast<double>(a.minY()) - b.maxY(),
+		static_cast<double>(b.minY()) - a.maxY() });
+	if (dx == 0 && dy == 0) return 0;
+	double units = std::sqrt(dx * dx + dy * dy);
+	return units / Mercator::unitsFromMeters(1, farthestY(a, b)) * LOWER_BOUND_FACTOR;
+}
+
+struct TileCandidate
+{
+	double bound;
+	Tile tile;
+	Tip tip;
+
+	bool operator>(const TileCandidate& other) const
+	{
+		return bound > other.bound;
+	}
+};
+
+struct Nearest
+{
+	double distance;
+	FeaturePtr feature;
+
+	/// Orders by distance, then by type and ID (so ties are broken the
+	/// same way regardless of the order in which tiles were searched)
+	bool operator<(const Nearest& other) const
+	{
+		if (distance != other.distance) return distance < other.distance;
+		if (feature.typeCode() != other.feature.typeCode())
+		{
+			return feature.typeCode() < other.feature.typeCode();
+		}
+		return feature.id() < other.feature.id();
+	}
+};
+
+/// \brief Best-first search for the k features of a selection that
+/// are nearest to a target.
+///
+/// Tiles are visited in the order of the minimum distance that any of
+/// their features can have from the target (the distance between the
+/// tile's bounds and the target's bounding box), and the k nearest
+/// features seen so far are kept in a bounded max-heap. The search
+/// ends as soon as the k-th nearest distance doesn't exceed the lower
+/// bound of the next tile.
+///
+/// Rather than walking the entire tile index up front, we only walk
+/// the tiles within a search box around the target, which we expand
+/// (by doubling its margin) once the nearest unvisited tile lies
+/// further away than the edge of the box.
+///
+class NearestSearch
+{
+public:
+	NearestSearch(PyFeatures* features, const Box& targetBounds,
+		DistanceMeasurer& measurer, size_t k, double maxDistance) :
+		features_(features),
+		store_(features->store),
+		targetBounds_(targetBounds),
+		measurer_(measurer),
+		k_(k),
+		maxDistance_(maxDistance),
+		margin_(INITIAL_MARGIN),
+		frontierBound_(0)
+	{
+	}
+
+	/// Runs the search (doesn't call into Python) and returns the
+	/// features ordered by distance
+	std::vector<Nearest> run()
+	{
+		for (;;)
+		{
+			double nextBound = tiles_.empty() ?
+				std::numeric_limits<double>::infinity() : tiles_.top().bound;
+			if (frontierBound_ < nextBound)
+			{
+				if (frontierBound_ > maxDistance_ || isComplete(frontierBound_)) break;
+				expand();
+				continue;
+			}
+			if (tiles_.empty() || nextBound > maxDistance_ || isComplete(nextBound)) break;
+			TileCandidate candidate = tiles_.top();
+			tiles_.pop();
+			searchTile(candidate.tile, candidate.tip);
+		}
+
+		std::vector<Nearest> results;
+		results.reserve(nearest_.size());
+		while (!nearest_.empty())
+		{
+			results.push_back(nearest_.top());
+			nearest_.pop();
+		}
+		std::reverse(results.begin(), results.end());
+		return results;
+	}
+
+private:
+	/// Checks whether none of the features that remain to be searched
+	/// (which are at least `bound` meters away) can be among the k nearest
+	bool isComplete(double bound) const
+	{
+		return nearest_.size() == k_ && nearest_.top().distance <= bound;
+	}
+
+	/// Grows the search box and queues the tiles that are new to it
+	void expand()
+	{
+		const Box& bounds = features_->bounds;
+		Box box(
+			clampToInt32(static_cast<int64_t>(targetBounds_.minX()) - margin_),
+			clampToInt32(static_cast<int64_t>(targetBounds_.minY()) - margin_),
+			clampToInt32(static_cast<int64_t>(targetBounds_.maxX()) + margin_),
+			clampToInt32(static_cast<int64_t>(targetBounds_.maxY()) + margin_));
+		Box searchBox = Box::simpleIntersection(box, bounds);
+		if (!searchBox.isEmpty())
+		{
+			TileIndexWalker tiw(store_->tileIndex(), store_->zoomLevels(),
+				searchBox, features_->filter);
+			do
+			{
+				Tip tip = tiw.currentTip();
+				if (!visitedTiles_.insert(tip.value()).second) continue;
+				Tile tile = tiw.currentTile();
+				tiles_.push({ lowerBound(targetBounds_, tile.bounds()), tile, tip });
+			}
+			while (tiw.next());
+		}
+
+		if (box.contains(bounds))
+		{
+			// The box covers the entire selection, nothing remains beyond
+			frontierBound_ = std::numeric_limits<double>::infinity();
+		}
+		else
+		{
+			// Anything outside the box is at least `margin_` units away
+			// from the target's bounding box
+			frontierBound_ = margin_ / Mercator::unitsFromMeters(1,
+				farthestY(box, targetBounds_)) * LOWER_BOUND_FACTOR;
+			margin_ *= 2;
+		}
+	}
+
+	void searchTile(Tile tile, Tip tip)
+	{
+		// The TileFilter accepts every feature stored in the tile (we
+		// take care of multi-tile features ourselves, since we don't
+		// visit all tiles)
+		Box tileBounds = tile.bounds();
+		const Filter* filter = new TileFilter(store_, tile, tip, tileBounds);
+		if (features_->filter)
+		{
+			const ComboFilter* combo = new ComboFilter(features_->filter, filter);
+			filter->release();   // ComboFilter holds its own ref
+			filter = combo;
+		}
+		{
+			Query query(store_, Box::simpleIntersection(features_->bounds, tileBounds),
+				features_->acceptedTypes, features_->matcher, filter);
+			for (;;)
+			{
+				FeaturePtr feature = query.next();
+				if (feature.isNull()) break;
+				if (!seenFeatures_.insert(feature.typedId()).second) continue;
+				double distance = measurer_.meters(0, feature);
+				if (!(distance <= maxDistance_)) continue;     // also skips NaN
+				add({ distance, feature });
+			}
+		}
+		filter->release();
+	}
+
+	void add(const Nearest& candidate)
+	{
+		if (nearest_.size() < k_)
+		{
+			nearest_.push(candidate);
+		}
+		else if (candidate < nearest_.top())
+		{
+			nearest_.pop();
+			nearest_.push(candidate);
+		}
+	}
+
+	PyFeatures* features_;
+	FeatureStore* store_;
+	Box targetBounds_;
+	DistanceMeasurer& measurer_;
+	size_t k_;
+	double maxDistance_;
+	int64_t margin_;
+	double frontierBound_;
+	std::priority_queue<TileCandidate, std::vector<TileCandidate>,
+		std::greater<TileCandidate>> tiles_;
+	std::priority_queue<Nearest> nearest_;		// farthest on top
+	std::unordered_set<uint32_t> visitedTiles_;
+	std::unordered_set<uint64_t> seenFeatures_;
+};
+
+} // namespace
+
+
+PyObject* filters::nearest_to(PyFeatures* self, PyObject* args, PyObject* kwargs)
+{
+	static const char* KEYWORDS[] = { "geom", "k", "max_distance", "units", nullptr };
+	PyObject* geomObj;
+	Py_ssize_t k = 1;
+	PyObject* maxDistanceObj = Py_None;
+	const char* unitsArg = nullptr;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|n$Os:nearest_to",
+		(char**)KEYWORDS, &geomObj, &k, &maxDistanceObj, &unitsArg))
+	{
+		return NULL;
+	}
+	if (k < 0)
+	{
+		PyErr_SetString(PyExc_ValueError, "k must not be negative");
+		return NULL;
+	}
+	int units = PyMercator::unitsFromArg(unitsArg, false);
+	if (units < 0) return NULL;
+	double maxDistance = std::numeric_limits<double>::infinity();
+	if (maxDistanceObj != Py_None)
+	{
+		maxDistance = PyFloat_AsDouble(maxDistanceObj);
+		if (maxDistance == -1 && PyErr_Occurred()) return NULL;
+		maxDistance = SpatialUnit::toMeters(maxDistance, units);
+	}
+
+	bool world = self->selectionType == &PyFeatures::World::SUBTYPE;
+	if (!world && self->selectionType != &PyFeatures::Empty::SUBTYPE)
+	{
+		PyErr_SetString(PyExc_TypeError,
+			"nearest_to() is not supported for selections of related "
+			"features (members, nodes or parents)");
+		return NULL;
+	}
+
+	GEOSContextHandle_t ctx = Environment::get().getGeosContext();
+	if (!ctx) return NULL;
+	ShapeHolder target;
+	if (!target.setFromObject(geomObj, ctx)) return NULL;
+	GEOSGeometry* targetGeom = target.asGeometry();
+	if (!targetGeom) return NULL;
+	if (!world || k == 0 || maxDistance < 0 || GEOSisEmpty_r(ctx, targetGeom) != 0)
+	{
+		return PyList_New(0);
+	}
+	double minX, minY, maxX, maxY;
+	if (!GEOSGeom_getXMin_r(ctx, targetGeom, &minX) ||
+		!GEOSGeom_getYMin_r(ctx, targetGeom, &minY) ||
+		!GEOSGeom_getXMax_r(ctx, targetGeom, &maxX) ||
+		!GEOSGeom_getYMax_r(ctx, targetGeom, &maxY))
+	{
+		return Python::geosError("nearest_to");
+	}
+	Box targetBounds(
+		clampToInt32(static_cast<int64_t>(std::floor(minX))),
+		clampToInt32(static_cast<int64_t>(std::floor(minY))),
+		clampToInt32(static_cast<int64_t>(std::ceil(maxX))),
+		clampToInt32(static_cast<int64_t>(std::ceil(maxY))));
+
+	DistanceMeasurer measurer(self->store, geomObj, targetGeom, 1);
+	NearestSearch search(self, targetBounds, measurer, static_cast<size_t>(k), maxDistance);
+	std::vector<Nearest> results;
+	Py_BEGIN_ALLOW_THREADS
+	results = search.run();
+	Py_END_ALLOW_THREADS
+
+	PyObject* list = PyList_New(results.size());
+	if (!list) return NULL;
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		PyObject* feature = PyFeature::create(self->store, results[i].feature, Py_None);
+		if (!feature)
+		{
+			Py_DECREF(list);
+			return NULL;
+		}
+		PyList_SET_ITEM(list, i, feature);
+	}
+	return list;
+}
@@ -0,0 +1,187 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "filters.h"
+#include <memory>
+#include <vector>
+#include <geodesk/filter/Filter.h>
+#include "python/util/util.h"
+#include "IdBitmap.h"
+
+
+/// \brief Accepts features whose IDs are in the IdBitmap for their type.
+///
+class IdFilter : public Filter
+{
+public:
+	IdFilter(std::shared_ptr<const IdBitmap> bitmaps[3], const Box& bounds)
+	{
+		uint32_t types = 0;
+		static const uint32_t TYPES[] =
+		{
+			FeatureTypes::NODES,
+			FeatureTypes::WAYS,
+			FeatureTypes::RELATIONS
+		};
+		for (int i = 0; i < 3; i++)
+		{
+			if (bitmaps[i] && !bitmaps[i]->isEmpty())
+			{
+				bitmaps_[i] = bitmaps[i];
+				types |= TYPES[i];
+			}
+		}
+		acceptedTypes_ = types;
+		bounds_ = bounds;
+	}
+
+	bool accept(FeatureStore* store, FeaturePtr feature, FastFilterHint fast) const override
+	{
+		const IdBitmap* bitmap = bitmaps_[feature.typeCode()].get();
+		return bitmap && bitmap->contains(feature.id());
+	}
+
+private:
+	std::shared_ptr<const IdBitmap> bitmaps_[3];
+};
+
+
+/// Appends the IDs in `obj` (an iterable of int, or an object that
+/// exposes a 1-D buffer of integers, such as a NumPy array) to `ids`
+static bool collectIds(PyObject* obj, std::vector<uint64_t>& ids)
+{
+	if (PyObject_CheckBuffer(obj) && !PyBytes_Check(obj) && !PyByteArray_Check(obj))
+	{
+		Py_buffer view;
+		if (PyObject_GetBuffer(obj, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0)
+		{
+			return false;
+		}
+		const char* format = view.format ? view.format : "B";
+		if (*format == '@' || *format == '=' || *format == '<') format++;
+		char code = format[0];
+		bool isSigned = code == 'b' || code == 'h' || code == 'i' ||
+			code == 'l' || code == 'q' || code == 'n';
+		bool isUnsigned = code == 'B' || code == 'H' || code == 'I' ||
+			code == 'L' || code == 'Q' || code == 'N';
+		if (format[1] != 0 || view.ndim > 1 || !(isSigned || isUnsigned))
+		{
+			PyErr_Format(PyExc_TypeError,
+				"IDs must be integers (buffer has format '%s')", view.format);
+			PyBuffer_Release(&view);
+			return false;
+		}
+		Py_ssize_t count = view.len / view.itemsize;
+		ids.reserve(ids.size() + count);
+		bool valid = true;
+		const char* p = static_cast<const char*>(view.buf);
+		for (Py_ssize_t i = 0; i < count; i++, p += view.itemsize)
+		{
+			int64_t id;
+			switch (view.itemsize)
+			{
+			case 1: id = isSigned ? *reinterpret_cast<const int8_t*>(p) : *reinterpret_cast<const uint8_t*>(p); break;
+			case 2: id = isSigned ? *reinterpret_cast<const int16_t*>(p) : *reinterpret_cast<const uint16_t*>(p); break;
+			case 4: id = isSigned ? *reinterpret_cast<const int32_t*>(p) : *reinterpret_cast<const uint32_t*>(p); break;
+			default: id = *reinterpret_cast<const int64_t*>(p); break;
+			}
+			if (id < 0)
+			{
+				valid = false;
+				break;
+			}
+			ids.push_back(static_cast<uint64_t>(id));
+		}
+		PyBuffer_Release(&view);
+		if (!valid)
+		{
+			PyErr_SetString(PyExc_ValueError, "IDs must not be negative");
+		}
+		return valid;
+	}
+
+	PyObject* iter = PyObject_GetIter(obj);
+	if (!iter) return false;
+	Py_ssize_t hint = PyObject_LengthHint(obj, 0);
+	if (hint < 0)
+	{
+		PyErr_Clear();
+	}
+	else
+	{
+		ids.reserve(ids.size() + hint);
+	}
+	PyObject* item;
+	while ((item = PyIter_Next(iter)))
+	{
+		long long id = PyLong_AsLongLong(item);
+		Py_DECREF(item);
+		if (id < 0)
+		{
+			if (!PyErr_Occurred())
+			{
+				PyErr_SetString(PyExc_ValueError, "IDs must not be negative");
+			}
+			Py_DECREF(iter);
+			return false;
+		}
+		ids.push_back(static_cast<uint64_t>(id));
+	}
+	Py_DECREF(iter);
+	return !PyErr_Occurred();
+}
+
+
+PyFeatures* filters::with_ids(PyFeatures* self, PyObject* args, PyObject* kwargs)
+{
+	static const char* KEYWORDS[] = { "ids", "nodes", "ways", "relations", NULL };
+	PyObject* idArgs[4] = {};
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O$OOO:with_ids",
+		const_cast<char**>(KEYWORDS), &idArgs[0], &idArgs[1], &idArgs[2], &idArgs[3]))
+	{
+		return NULL;
+	}
+	if (!(idArgs[0] || idArgs[1] || idArgs[2] || idArgs[3]))
+	{
+		PyErr_SetString(PyExc_TypeError,
+			"with_ids() expects IDs (ids, nodes, ways or relations)");
+		return NULL;
+	}
+
+	// IDs passed as `ids` apply to all types; `nodes`, `ways` and
+	// `relations` only apply to features of that type
+	std::vector<uint64_t> ids[4];
+	for (int i = 0; i < 4; i++)
+	{
+		if (idArgs[i] && !collectIds(idArgs[i], ids[i])) return NULL;
+	}
+
+	std::shared_ptr<const IdBitmap> bitmaps[3];
+	Py_BEGIN_ALLOW_THREADS
+	for (int i = 0; i < 3; i++)
+	{
+		if (idArgs[i + 1])
+		{
+			ids[i + 1].insert(ids[i + 1].end(), ids[0].begin(), ids[0].end());
+			bitmaps[i] = std::make_shared<IdBitmap>(ids[i + 1]);
+		}
+	}
+	if (idArgs[0])
+	{
+		std::shared_ptr<const IdBitmap> shared = std::make_shared<IdBitmap>(ids[0]);
+		for (int i = 0; i < 3; i++)
+		{
+			if (!bitmaps[i]) bitmaps[i] = shared;
+		}
+	}
+	Py_END_ALLOW_THREADS
+
+	const Filter* filter = new IdFilter(bitmaps,
+		(self->flags & SelectionFlags::USES_BOUNDS) ? self->bounds : Box::ofWorld());
+	if (filter->acceptedTypes() == 0)
+	{
+		filter->release();
+		return self->getEmpty();
+	}
+	return self->withFilter(filter);
+}
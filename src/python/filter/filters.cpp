@@ -6,7 +6,9 @@
 #include "python/Environment.h"
 #include "python/feature/PyFeature.h"
 #include "python/geom/PyBox.h"
+#include "python/geom/GeometryCache.h"
 #include "python/geom/PyCoordinate.h"
+#include "python/query/StoreState.h"
 #include "python/util/util.h"
 
 
@@ -45,13 +47,6 @@ PyFeatures* filters::max_meters_from(PyFeatures* self, PyObject* args, PyObject*
 	return NULL;
 }
 
-PyFeatures* filters::nearest_to(PyFeatures* self, PyObject* args, PyObject* kwargs)
-{
-	PyErr_SetString(PyExc_NotImplementedError,
-		"nearest_to has not been implemented yet");
-	return NULL;
-}
-
 PyFeatures* filters::overlapping(PyFeatures* self, PyObject* args, PyObject* kwargs)
 {
 	PyErr_SetString(PyExc_NotImplementedError,
@@ -74,6 +69,20 @@ PyFeatures* filters::touching(PyFeatures* self, PyObject* args, PyObject* kwargs
 }
 
 
+const Filter* filters::forFeature(PreparedFilterFactory& factory,
+	FeatureStore* store, FeaturePtr feature)
+{
+	if (feature.isNode()) return factory.forCoordinate(NodePtr(feature).xy());
+	GEOSContextHandle_t context = Environment::get().getGeosContext();
+	if (!context) return nullptr;
+	CachedGeometryRef cached = StoreState::of(store)->geometries().get(
+		store, feature, context);
+	if (!cached) return nullptr;
+	// The factory doesn't modify the geometry, nor does the filter
+	// hold on to it
+	return factory.forGeometry(context, const_cast<GEOSGeometry*>(cached->geometry()));
+}
+
 PyFeatures* filters::filter(PyFeatures* self, PyObject* args, PyObject* kwargs, PreparedFilterFactory& factory)
 {
 	PyObject* arg = Python::checkSingleArg(args, kwargs, "geom");
@@ -85,7 +94,7 @@ PyFeatures* filters::filter(PyFeatures* self, PyObject* args, PyObject* kwargs,
 	if (type == &PyFeature::TYPE)
 	{
 		PyFeature* feature = (PyFeature*)arg;
-		filter = factory.forFeature(feature->store, feature->feature);
+		filter = forFeature(factory, feature->store, feature->feature);
 	}
 	else if (Environment::get().getGeosGeometry(arg, &geom))
 	{
@@ -116,6 +125,7 @@ PyFeatures* filters::filter(PyFeatures* self, PyObject* args, PyObject* kwargs,
 	}
 
 	if (filter) return self->withFilter(filter);
+	if (PyErr_Occurred()) return NULL;
 	return self->getEmpty();
 }
 
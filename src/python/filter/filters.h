@@ -8,6 +8,13 @@
 namespace filters
 {
 	extern PyFeatures* filter(PyFeatures* self, PyObject* args, PyObject* kwargs, PreparedFilterFactory& factory);
+	/**
+	 * Creates a spatial filter for a feature, using the cached geometry
+	 * of a way or relation (see GeometryCache). Returns null if the
+	 * geometry couldn't be built (with a Python exception set).
+	 */
+	extern const Filter* forFeature(PreparedFilterFactory& factory,
+		FeatureStore* store, FeaturePtr feature);
 	extern PyFeatures* ancestors_of(PyFeatures* self, PyObject* args, PyObject* kwargs);
 	extern PyFeatures* around(PyFeatures* self, PyObject* args, PyObject* kwargs);
 	extern PyFeatures* connected_to(PyFeatures* self, PyObject* args, PyObject* kwargs);
@@ -17,6 +24,7 @@ namespace filters
 	extern PyFeatures* crossing(PyFeatures* self, PyObject* args, PyObject* kwargs);
 	extern PyFeatures* descendants_of(PyFeatures* self, PyObject* args, PyObject* kwargs);
 	extern PyFeatures* disjoint_from(PyFeatures* self, PyObject* args, PyObject* kwargs);
+	extern PyFeatures* in_set(PyFeatures* self, PyObject* args, PyObject* kwargs);
 	extern PyFeatures* intersecting(PyFeatures* self, PyObject* args, PyObject* kwargs);
 	extern PyFeatures* max_area(PyFeatures* self, PyObject* args, PyObject* kwargs);
 	extern PyFeatures* max_length(PyFeatures* self, PyObject* args, PyObject* kwargs);
@@ -24,13 +32,14 @@ namespace filters
 	extern PyFeatures* min_area(PyFeatures* self, PyObject* args, PyObject* kwargs);
 	extern PyFeatures* members_of(PyFeatures* self, PyObject* args, PyObject* kwargs);
 	extern PyFeatures* min_length(PyFeatures* self, PyObject* args, PyObject* kwargs);
-	extern PyFeatures* nearest_to(PyFeatures* self, PyObject* args, PyObject* kwargs);
+	extern PyObject* nearest_to(PyFeatures* self, PyObject* args, PyObject* kwargs);
 	extern PyFeatures* nodes_of(PyFeatures* self, PyObject* args, PyObject* kwargs);
 	extern PyFeatures* overlapping(PyFeatures* self, PyObject* args, PyObject* kwargs);
 	extern PyFeatures* parents_of(PyFeatures* self, PyObject* args, PyObject* kwargs);
 	extern PyFeatures* pythonFilter(PyFeatures* self, PyObject* args, PyObject* kwargs);
 	extern PyFeatures* touching(PyFeatures* self, PyObject* args, PyObject* kwargs);
 	extern PyFeatures* with_role(PyFeatures* self, PyObject* args, PyObject* kwargs);
+	extern PyFeatures* with_ids(PyFeatures* self, PyObject* args, PyObject* kwargs);
 	extern PyFeatures* within(PyFeatures* self, PyObject* args, PyObject* kwargs);
 }
 
@@ -8,7 +8,9 @@
 #include <geodesk/format/FeatureWriter.h>
 #include <geodesk/format/GeoJsonWriter.h>
 #include <geodesk/format/WktWriter.h>
+#include <geodesk/query/Query.h>
 #include "python/feature/PyFeature.h"
+#include "python/query/PyFeatures.h"
 #include "python/util/PyFastMethod.h"
 #include "python/util/util.h"
 
@@ -181,6 +183,11 @@ void PyFormatter::write(FeatureWriter* writer)
 		PyAnonymousNode* node = (PyAnonymousNode*)target;
 		writer->writeAnonymousNodeNode(Coordinate(node->x_, node->y_));
 	}
+	else if (type == &PyFeatures::TYPE && idSchema == nullptr &&
+		((PyFeatures*)target)->selectionType == &PyFeatures::World::SUBTYPE)
+	{
+		writeQuery(writer, (PyFeatures*)target);
+	}
 	else if (Python::isIterable(target))
 	{
 		writer->writeHeader();
@@ -209,6 +216,33 @@ void PyFormatter::write(FeatureWriter* writer)
 	writer->flush();
 }
 
+/**
+ * Writes the results of a query directly, without turning them into
+ * Feature objects. Since the writer doesn't need to call back into
+ * Python (there is no id callable), we can release the GIL while the
+ * query runs and the output is written.
+ */
+void PyFormatter::writeQuery(FeatureWriter* writer, PyFeatures* features)
+{
+	int64_t maxCount = limit;
+	writer->writeHeader();
+	Py_BEGIN_ALLOW_THREADS
+	{
+		Query query(features->store, features->bounds, features->acceptedTypes,
+			features->matcher, features->filter);
+		int64_t count = 0;
+		while (count < maxCount)
+		{
+			FeaturePtr feature = query.next();
+			if (feature.isNull()) break;
+			writer->writeFeature(features->store, feature);
+			count++;
+		}
+	}
+	Py_END_ALLOW_THREADS
+	writer->writeFooter();
+}
+
 PyObject* PyFormatter::save(PyFormatter* self, PyObject* args, PyObject* kwargs)
 {
 	PyObject* arg = Python::checkSingleArg(args, kwargs, "<filename>");
@@ -15,6 +15,7 @@ namespace geodesk {
 class FeatureStore;
 class FeatureWriter;
 }
+class PyFeatures;
 
 class PyFormatter : public PyObject
 {
@@ -77,6 +78,7 @@ public:
 
 	static PyObject* save(PyFormatter* self, PyObject* args, PyObject* kwargs);
 	void write(FeatureWriter* writer);
+	void writeQuery(FeatureWriter* writer, PyFeatures* features);
 	
 	static void writeIdViaCallable(FeatureWriter* writer,
 		FeatureStore* store, FeaturePtr feature, /* PyObject */ void* closure);
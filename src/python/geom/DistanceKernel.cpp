@@ -0,0 +1,250 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "DistanceKernel.h"
+#include <algorithm>
+#include <limits>
+#include <geodesk/feature/NodePtr.h>
+#include <geodesk/feature/WayCoordinateIterator.h>
+#include <geodesk/feature/WayPtr.h>
+#include "python/feature/PyFeature.h"
+#include "python/geom/PyBox.h"
+#include "python/geom/PyCoordinate.h"
+
+using namespace geodesk;
+
+bool DistanceKernel::Shape::setFromObject(PyObject* obj)
+{
+    x.clear();
+    y.clear();
+    isArea_ = false;
+    PyTypeObject* type = Py_TYPE(obj);
+    if (type == &PyCoordinate::TYPE)
+    {
+        PyCoordinate* c = static_cast<PyCoordinate*>(obj);
+        add(c->x, c->y);
+        return true;
+    }
+    if (type == &PyAnonymousNode::TYPE)
+    {
+        PyAnonymousNode* node = static_cast<PyAnonymousNode*>(obj);
+        add(node->x_, node->y_);
+        return true;
+    }
+    if (type == &PyBox::TYPE)
+    {
+        const Box& box = static_cast<PyBox*>(obj)->box;
+        if (box.isEmpty()) return false;
+        add(box.minX(), box.minY());
+        add(box.maxX(), box.minY());
+        add(box.maxX(), box.maxY());
+        add(box.minX(), box.maxY());
+        add(box.minX(), box.minY());
+        isArea_ = true;
+        return true;
+    }
+    if (type == &PyFeature::TYPE)
+    {
+        return setFromFeature(static_cast<PyFeature*>(obj)->feature);
+    }
+    return false;
+}
+
+bool DistanceKernel::Shape::setFromFeature(FeaturePtr feature)
+{
+    x.clear();
+    y.clear();
+    isArea_ = false;
+    if (feature.isNode())
+    {
+        Coordinate xy = NodePtr(feature).xy();
+        add(xy.x, xy.y);
+        return true;
+    }
+    if (!feature.isWay()) return false;
+    WayPtr way(feature);
+    WayCoordinateIterator iter(way);
+    int count = iter.coordinatesRemaining();
+    x.reserve(count + 1);
+    y.reserve(count + 1);
+    for (int i = 0; i < count; i++)
+    {
+        Coordinate c = iter.next();
+        add(c.x, c.y);
+    }
+    if (x.empty()) return false;
+    if (way.isArea())
+    {
+        // Make sure the ring is closed
+        if (x.front() != x.back() || y.front() != y.back()) add(x.front(), y.front());
+        isArea_ = true;
+    }
+    return true;
+}
+
+double DistanceKernel::nearestOnOutline(const Shape& s, double px, double py,
+    double& qx, double& qy)
+{
+    const double* xs = s.x.data();
+    const double* ys = s.y.data();
+    size_t segments = s.size() - 1;
+    if (segments == 0)
+    {
+        qx = xs[0];
+        qy = ys[0];
+        return (qx - px) * (qx - px) + (qy - py) * (qy - py);
+    }
+
+    // We compute the squared distances for a block of segments at a
+    // time; the loop has no branches or dependencies between iterations,
+    // so it is vectorized. Only then do we look for the closest segment.
+    const size_t BLOCK_SIZE = 64;
+    double dist[BLOCK_SIZE];
+    double best = std::numeric_limits<double>::infinity();
+    size_t bestSegment = 0;
+    for (size_t start = 0; start < segments; start += BLOCK_SIZE)
+    {
+        size_t n = std::min(BLOCK_SIZE, segments - start);
+        const double* ax = xs + start;
+        const double* ay = ys + start;
+        for (size_t i = 0; i < n; i++)
+        {
+            double dx = ax[i + 1] - ax[i];
+            double dy = ay[i + 1] - ay[i];
+            double len = dx * dx + dy * dy;
+            double t = ((px - ax[i]) * dx + (py - ay[i]) * dy) / (len > 0 ? len : 1);
+            t = t < 0 ? 0 : (t > 1 ? 1 : t);
+            double ex = ax[i] + t * dx - px;
+            double ey = ay[i] + t * dy - py;
+            dist[i] = ex * ex + ey * ey;
+        }
+        for (size_t i = 0; i < n; i++)
+        {
+            if (dist[i] < best)
+            {
+                best = dist[i];
+                bestSegment = start + i;
+            }
+        }
+    }
+
+    double ax = xs[bestSegment];
+    double ay = ys[bestSegment];
+    double dx = xs[bestSegment + 1] - ax;
+    double dy = ys[bestSegment + 1] - ay;
+    double len = dx * dx + dy * dy;
+    double t = len > 0 ? ((px - ax) * dx + (py - ay) * dy) / len : 0;
+    t = std::clamp(t, 0.0, 1.0);
+    qx = ax + t * dx;
+    qy = ay + t * dy;
+    return best;
+}
+
+
+bool DistanceKernel::containsPoint(const Shape& ring, double px, double py)
+{
+    // Crossing-number test (the ring is closed)
+    const double* xs = ring.x.data();
+    const double* ys = ring.y.data();
+    bool inside = false;
+    for (size_t i = 1; i < ring.size(); i++)
+    {
+        double x1 = xs[i - 1], y1 = ys[i - 1];
+        double x2 = xs[i], y2 = ys[i];
+        if ((y1 > py) != (y2 > py) &&
+            px < x1 + (py - y1) * (x2 - x1) / (y2 - y1))
+        {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+
+bool DistanceKernel::findCrossing(const Shape& a, const Shape& b, double& x, double& y)
+{
+    for (size_t i = 1; i < a.size(); i++)
+    {
+        double ax1 = a.x[i - 1], ay1 = a.y[i - 1];
+        double ax2 = a.x[i], ay2 = a.y[i];
+        double minX = std::min(ax1, ax2), maxX = std::max(ax1, ax2);
+        double minY = std::min(ay1, ay2), maxY = std::max(ay1, ay2);
+        double adx = ax2 - ax1, ady = ay2 - ay1;
+        for (size_t j = 1; j < b.size(); j++)
+        {
+            double bx1 = b.x[j - 1], by1 = b.y[j - 1];
+            double bx2 = b.x[j], by2 = b.y[j];
+            if (std::max(bx1, bx2) < minX || std::min(bx1, bx2) > maxX ||
+                std::max(by1, by2) < minY || std::min(by1, by2) > maxY)
+            {
+                continue;
+            }
+            double bdx = bx2 - bx1, bdy = by2 - by1;
+            double denom = adx * bdy - ady * bdx;
+            if (denom == 0) continue;
+                // Parallel segments can only touch at an endpoint,
+                // which the point-to-segment distances take care of
+            double t = ((bx1 - ax1) * bdy - (by1 - ay1) * bdx) / denom;
+            double u = ((bx1 - ax1) * ady - (by1 - ay1) * adx) / denom;
+            if (t >= 0 && t <= 1 && u >= 0 && u <= 1)
+            {
+                x = ax1 + t * adx;
+                y = ay1 + t * ady;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+bool DistanceKernel::nearestPoints(const Shape& a, const Shape& b, NearestPoints& result)
+{
+    if (a.size() * b.size() > MAX_SEGMENT_PAIRS) return false;
+
+    // A shape that lies (partly) inside an area is at distance 0; if
+    // its first vertex isn't inside, then either all of it is outside,
+    // or its outline crosses the area's outline
+    if (a.isArea() && containsPoint(a, b.x[0], b.y[0]))
+    {
+        result = { b.x[0], b.y[0], b.x[0], b.y[0] };
+        return true;
+    }
+    if (b.isArea() && containsPoint(b, a.x[0], a.y[0]))
+    {
+        result = { a.x[0], a.y[0], a.x[0], a.y[0] };
+        return true;
+    }
+    double cx, cy;
+    if (a.size() > 1 && b.size() > 1 && findCrossing(a, b, cx, cy))
+    {
+        result = { cx, cy, cx, cy };
+        return true;
+    }
+
+    // Otherwise, one of the nearest points is a vertex
+    double best = std::numeric_limits<double>::infinity();
+    double qx, qy;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        double d = nearestOnOutline(b, a.x[i], a.y[i], qx, qy);
+        if (d < best)
+        {
+            best = d;
+            result = { a.x[i], a.y[i], qx, qy };
+        }
+    }
+    if (a.size() > 1)
+    {
+        for (size_t i = 0; i < b.size(); i++)
+        {
+            double d = nearestOnOutline(a, b.x[i], b.y[i], qx, qy);
+            if (d < best)
+            {
+                best = d;
+                result = { qx, qy, b.x[i], b.y[i] };
+            }
+        }
+    }
+    return true;
+}
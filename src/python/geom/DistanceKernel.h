@@ -0,0 +1,77 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#pragma once
+
+#include <Python.h>
+#include <cstddef>
+#include <vector>
+#include <geodesk/feature/FeaturePtr.h>
+
+using namespace geodesk;
+
+/// \brief Finds the nearest points of two simple geometries (points,
+/// ways and boxes) directly from their Mercator coordinates, without
+/// building GEOS geometries.
+///
+/// Coordinates are decoded into separate x and y arrays, so the
+/// point-to-segment distances are computed by a branch-free loop over
+/// contiguous memory, which the compiler vectorizes.
+///
+/// Relations and Shapely geometries (as well as pairs of ways with
+/// very many vertices, where GEOS's indexed algorithm wins) aren't
+/// handled; in this case, callers fall back to GEOS.
+///
+class DistanceKernel
+{
+public:
+    /// A point, a linestring, or a closed ring whose interior belongs
+    /// to the geometry (an area way or a box)
+    class Shape
+    {
+    public:
+        /// Loads the coordinates of a Coordinate, Box or Feature
+        /// (other than a relation); returns false (without setting
+        /// an exception) if the object isn't supported
+        bool setFromObject(PyObject* obj);
+        /// Loads the coordinates of a node or way; returns false
+        /// for a relation
+        bool setFromFeature(FeaturePtr feature);
+
+        size_t size() const { return x.size(); }
+        bool isArea() const { return isArea_; }
+
+        std::vector<double> x;
+        std::vector<double> y;
+
+    private:
+        void add(double px, double py)
+        {
+            x.push_back(px);
+            y.push_back(py);
+        }
+
+        bool isArea_ = false;
+    };
+
+    struct NearestPoints
+    {
+        double x1, y1;      // on the first shape
+        double x2, y2;      // on the second shape
+    };
+
+    /// Finds the nearest points of two shapes; returns false if the
+    /// shapes are too complex (in which case GEOS does a better job)
+    static bool nearestPoints(const Shape& a, const Shape& b, NearestPoints& result);
+
+private:
+    /// Upper limit for the number of segment pairs we test
+    static const size_t MAX_SEGMENT_PAIRS = 1 << 22;
+
+    /// Returns the squared distance from (px,py) to the nearest point
+    /// of the shape's outline, which is stored in (qx,qy)
+    static double nearestOnOutline(const Shape& s, double px, double py,
+        double& qx, double& qy);
+    static bool containsPoint(const Shape& ring, double px, double py);
+    static bool findCrossing(const Shape& a, const Shape& b, double& x, double& y);
+};
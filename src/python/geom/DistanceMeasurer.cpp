@@ -0,0 +1,60 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "DistanceMeasurer.h"
+#include <cmath>
+#include <geodesk/geom/Distance.h>
+#include <geodesk/geom/GeometryBuilder.h>
+#include "python/Environment.h"
+
+DistanceMeasurer::Slot::~Slot()
+{
+    GEOSContextHandle_t context = Environment::get().getGeosContext();
+    if (prepared) GEOSPreparedGeom_destroy_r(context, prepared);
+    if (target) GEOSGeom_destroy_r(context, target);
+}
+
+DistanceMeasurer::DistanceMeasurer(FeatureStore* store, PyObject* targetObj,
+    const GEOSGeometry* target, int slots) :
+    store_(store),
+    target_(target),
+    slots_(slots)
+{
+    targetIsSimple_ = targetShape_.setFromObject(targetObj);
+}
+
+double DistanceMeasurer::meters(int slotNumber, FeaturePtr feature)
+{
+    Slot& slot = slots_[slotNumber];
+    DistanceKernel::NearestPoints nearest;
+    if (targetIsSimple_ && slot.shape.setFromFeature(feature) &&
+        DistanceKernel::nearestPoints(slot.shape, targetShape_, nearest))
+    {
+        return Distance::metersBetween(nearest.x1, nearest.y1, nearest.x2, nearest.y2);
+    }
+    return metersViaGeos(slot, feature);
+}
+
+double DistanceMeasurer::metersViaGeos(Slot& slot, FeaturePtr feature)
+{
+    GEOSContextHandle_t ctx = Environment::get().getGeosContext();
+    if (!ctx) return NAN;
+    if (!slot.prepared)
+    {
+        if (!slot.target) slot.target = GEOSGeom_clone_r(ctx, target_);
+        if (!slot.target) return NAN;
+        slot.prepared = GEOSPrepare_r(ctx, slot.target);
+        if (!slot.prepared) return NAN;
+    }
+    GEOSGeometry* geom = GeometryBuilder::buildFeatureGeometry(store_, feature, ctx);
+    if (!geom) return NAN;
+    GEOSCoordSequence* nearestPoints = GEOSPreparedNearestPoints_r(ctx, slot.prepared, geom);
+    GEOSGeom_destroy_r(ctx, geom);
+    if (!nearestPoints) return NAN;
+    double x1, y1, x2, y2;
+    bool success =
+        GEOSCoordSeq_getXY_r(ctx, nearestPoints, 0, &x1, &y1) &&
+        GEOSCoordSeq_getXY_r(ctx, nearestPoints, 1, &x2, &y2);
+    GEOSCoordSeq_destroy_r(ctx, nearestPoints);
+    return success ? Distance::metersBetween(x1, y1, x2, y2) : NAN;
+}
@@ -0,0 +1,59 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#pragma once
+
+#include <Python.h>
+#include <vector>
+#include <geos_c.h>
+#include <geodesk/feature/FeaturePtr.h>
+#include "DistanceKernel.h"
+
+namespace geodesk {
+class FeatureStore;
+}
+using namespace geodesk;
+
+/// \brief Measures the distances between features and a target geometry.
+///
+/// Nodes and ways are measured against the target's coordinates by
+/// the DistanceKernel; relations (or all features, if the target is
+/// something the kernel can't handle) are measured via GEOS, against
+/// a prepared copy of the target that each thread creates on first
+/// use (a prepared geometry builds its index lazily, so threads
+/// can't share one).
+///
+/// Each thread that measures distances must use its own slot.
+/// meters() doesn't call into Python, so it can be used without
+/// holding the GIL.
+///
+class DistanceMeasurer
+{
+public:
+    /// Creates a measurer for the given target (a Python object that
+    /// is accepted by ShapeHolder), whose GEOS geometry must outlive
+    /// the measurer. Must be called with the GIL held.
+    DistanceMeasurer(FeatureStore* store, PyObject* targetObj,
+        const GEOSGeometry* target, int slots);
+
+    /// Returns the distance in meters, or NaN if it couldn't be measured
+    double meters(int slot, FeaturePtr feature);
+
+private:
+    struct Slot
+    {
+        DistanceKernel::Shape shape;
+        GEOSGeometry* target = nullptr;     // this thread's copy of the target
+        const GEOSPreparedGeometry* prepared = nullptr;
+
+        ~Slot();
+    };
+
+    double metersViaGeos(Slot& slot, FeaturePtr feature);
+
+    FeatureStore* store_;
+    const GEOSGeometry* target_;
+    bool targetIsSimple_;
+    DistanceKernel::Shape targetShape_;
+    std::vector<Slot> slots_;
+};
@@ -0,0 +1,118 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "GeometryCache.h"
+#include <geodesk/feature/FeatureStore.h>
+#include <geodesk/geom/GeometryBuilder.h>
+#include "python/Environment.h"
+
+// GEOS doesn't tell us how much memory a geometry occupies, so we
+// estimate it based on its number of coordinates (a coordinate takes
+// up to 24 bytes, plus some overhead per geometry)
+
+static const size_t BYTES_PER_COORDINATE = 24;
+static const size_t BYTES_PER_GEOMETRY = 128;
+
+static size_t estimateBytes(GEOSContextHandle_t context, const GEOSGeometry* geom)
+{
+    int coords = GEOSGetNumCoordinates_r(context, geom);
+    return BYTES_PER_GEOMETRY + (coords > 0 ? coords * BYTES_PER_COORDINATE : 0);
+}
+
+CachedGeometry::~CachedGeometry()
+{
+    // The last reference may be dropped on a different thread than the
+    // one that built the geometry, so we use the current thread's context
+    GEOSContextHandle_t context = Environment::get().getGeosContext();
+    GEOSGeom_destroy_r(context, geom_);
+}
+
+
+GeometryCache::GeometryCache() :
+    bytes_(0),
+    maxBytes_(DEFAULT_MAX_BYTES),
+    hits_(0),
+    misses_(0),
+    evictions_(0)
+{
+}
+
+CachedGeometryRef GeometryCache::get(FeatureStore* store, FeaturePtr feature,
+    GEOSContextHandle_t context)
+{
+    uint64_t typedId = feature.typedId();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(typedId);
+        if (it != index_.end())
+        {
+            // Move the entry to the front of the LRU list
+            entries_.splice(entries_.begin(), entries_, it->second);
+            hits_++;
+            return *it->second;
+        }
+        misses_++;
+    }
+
+    // Build the geometry without holding the lock (polygonizing a
+    // large relation may take a while)
+    GEOSGeometry* geom = feature.isWay() ?
+        GeometryBuilder::buildWayGeometry(WayPtr(feature), context) :
+        GeometryBuilder::buildRelationGeometry(store, RelationPtr(feature), context);
+    if (!geom)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "Failed to build GEOS Geometry");
+        return nullptr;
+    }
+    CachedGeometryRef cached = std::make_shared<CachedGeometry>(
+        typedId, geom, estimateBytes(context, geom));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cached->bytes() > maxBytes_ || index_.count(typedId)) return cached;
+    entries_.push_front(cached);
+    index_[typedId] = entries_.begin();
+    bytes_ += cached->bytes();
+    evict();
+    return cached;
+}
+
+void GeometryCache::evict()
+{
+    // Called with the lock held. Evicted geometries that are still
+    // in use are freed once their last user releases them.
+    while (bytes_ > maxBytes_ && !entries_.empty())
+    {
+        const CachedGeometryRef& geom = entries_.back();
+        bytes_ -= geom->bytes();
+        index_.erase(geom->typedId_);
+        entries_.pop_back();
+        evictions_++;
+    }
+}
+
+void GeometryCache::setMaxBytes(size_t maxBytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxBytes_ = maxBytes;
+    evict();
+}
+
+void GeometryCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_.clear();
+    entries_.clear();
+    bytes_ = 0;
+}
+
+PyObject* GeometryCache::stats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return Py_BuildValue("{s:K,s:K,s:K,s:n,s:n,s:n}",
+        "hits", (unsigned long long)hits_,
+        "misses", (unsigned long long)misses_,
+        "evictions", (unsigned long long)evictions_,
+        "entries", (Py_ssize_t)entries_.size(),
+        "bytes", (Py_ssize_t)bytes_,
+        "max_bytes", (Py_ssize_t)maxBytes_);
+}
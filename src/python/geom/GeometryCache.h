@@ -0,0 +1,91 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#pragma once
+
+#include <Python.h>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <geos_c.h>
+#include <geodesk/feature/FeaturePtr.h>
+
+namespace geodesk {
+class FeatureStore;
+}
+using namespace geodesk;
+
+/// \brief The GEOS geometry of a way or relation.
+///
+/// Geometries are shared between the cache and their users, so a
+/// geometry that is evicted while in use stays valid until the last
+/// user lets go of it. Users must not modify the geometry.
+///
+class CachedGeometry
+{
+public:
+    CachedGeometry(uint64_t typedId, GEOSGeometry* geom, size_t bytes) :
+        typedId_(typedId), geom_(geom), bytes_(bytes) {}
+    ~CachedGeometry();
+
+    const GEOSGeometry* geometry() const { return geom_; }
+    size_t bytes() const { return bytes_; }
+
+private:
+    uint64_t typedId_;
+    GEOSGeometry* geom_;
+    size_t bytes_;
+
+    friend class GeometryCache;
+};
+
+typedef std::shared_ptr<CachedGeometry> CachedGeometryRef;
+
+/// \brief An LRU cache of the GEOS geometries of the ways and
+/// relations of a FeatureStore, keyed by typed ID.
+///
+/// Building a geometry means decoding the coordinates of a way, and
+/// for area relations assembling the rings of all member ways into
+/// polygons, which is far more expensive than any single operation
+/// we perform with it. Scripts tend to use the same few geometries
+/// (such as an admin boundary) over and over, so we keep recently
+/// used ones until their estimated size exceeds the cache's budget.
+///
+/// Each store has its own cache (see StoreState::geometries()).
+///
+class GeometryCache
+{
+public:
+    GeometryCache();
+
+    /// Returns the geometry of a way or relation, building it if it
+    /// isn't cached. Returns null (with a Python exception set) if
+    /// the geometry couldn't be built.
+    CachedGeometryRef get(FeatureStore* store, FeaturePtr feature,
+        GEOSContextHandle_t context);
+
+    size_t maxBytes() const { return maxBytes_; }
+    /// Sets the budget (0 disables the cache), evicting geometries if needed
+    void setMaxBytes(size_t maxBytes);
+    void clear();
+    bool isEmpty() const { return entries_.empty(); }
+
+    /// Returns the cache statistics as a dict
+    PyObject* stats();
+
+    static const size_t DEFAULT_MAX_BYTES = 64 * 1024 * 1024;
+
+private:
+    void evict();
+
+    std::mutex mutex_;
+    std::list<CachedGeometryRef> entries_;      // most recently used first
+    std::unordered_map<uint64_t, std::list<CachedGeometryRef>::iterator> index_;
+    size_t bytes_;
+    size_t maxBytes_;
+    uint64_t hits_;
+    uint64_t misses_;
+    uint64_t evictions_;
+};
@@ -4,6 +4,7 @@
 #include "PyMercator.h"
 #include <geodesk/geom/Distance.h>
 #include <geodesk/geom/SpatialUnit.h>
+#include "DistanceKernel.h"
 #include "ShapeHolder.h"
 #include "python/Environment.h"
 
@@ -51,21 +52,26 @@ PyObject* PyMercator::distance (PyObject* self, PyObject* args, PyObject* kwargs
     if (res == 0) return NULL;
     int units = unitsFromArg(unitsArg, false);
     if (units < 0) return NULL;
-    if (!g1.setFromObject(obj1, ctx)) return NULL;
-    if (!g2.setFromObject(obj2, ctx)) return NULL;
 
     double x1, y1, x2, y2;
-    if (g1.isCoordinate() && g2.isCoordinate())
+
+    // Points, ways and boxes are handled natively; for anything else
+    // (or for very large pairs of ways), we let GEOS do the work
+    DistanceKernel::Shape s1;
+    DistanceKernel::Shape s2;
+    DistanceKernel::NearestPoints nearest;
+    if (s1.setFromObject(obj1) && s2.setFromObject(obj2) &&
+        DistanceKernel::nearestPoints(s1, s2, nearest))
     {
-        Coordinate c1 = g1.coordinate();
-        x1 = c1.x;
-        y1 = c1.y;
-        Coordinate c2 = g2.coordinate();
-        x2 = c2.x;
-        y2 = c2.y;
+        x1 = nearest.x1;
+        y1 = nearest.y1;
+        x2 = nearest.x2;
+        y2 = nearest.y2;
     }
     else
     {
+        if (!g1.setFromObject(obj1, ctx)) return NULL;
+        if (!g2.setFromObject(obj2, ctx)) return NULL;
         GEOSCoordSequence *nearestPoints = GEOSNearestPoints_r
             (ctx, g1.asGeometry(), g2.asGeometry());
         if (!nearestPoints) [[unlikely]]
@@ -7,6 +7,7 @@
 #include "python/feature/PyFeature.h"
 #include "python/geom/PyBox.h"
 #include "python/geom/PyCoordinate.h"
+#include "python/query/StoreState.h"
 
 using namespace clarisma;
 using namespace geodesk;
@@ -18,6 +19,7 @@ bool ShapeHolder::setFromObject(PyObject* obj, GEOSContextHandle_t ctx)
         GEOSGeom_destroy_r(context_, geom_.ptr());
         geom_ = TaggedPtr<GEOSGeometry,1>();
     }
+    cached_.reset();
     context_ = ctx;
     coord_ = Coordinate();
 
@@ -42,15 +44,13 @@ bool ShapeHolder::setFromObject(PyObject* obj, GEOSContextHandle_t ctx)
             coord_ = node.xy();
             return true;
         }
-        if (feature.isWay())
-        {
-            geom = GeometryBuilder::buildWayGeometry(WayPtr(feature), ctx);
-        }
-        else
-        {
-            geom = GeometryBuilder::buildRelationGeometry(
-                f->store, RelationPtr(feature), ctx);
-        }
+        // Feature geometries come from the store's cache; we only
+        // borrow them, so the GEOS operations must not modify them
+        cached_ = StoreState::of(f->store)->geometries().get(f->store, feature, ctx);
+        if (!cached_) return false;
+        geom_ = TaggedPtr<GEOSGeometry,1>(
+            const_cast<GEOSGeometry*>(cached_->geometry()), 0);
+        return true;
     }
     else if (type == &PyAnonymousNode::TYPE)
     {
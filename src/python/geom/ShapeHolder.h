@@ -7,6 +7,7 @@
 #include <geos_c.h>
 #include <clarisma/util/TaggedPtr.h>
 #include <geodesk/geom/GeometryBuilder.h>
+#include "GeometryCache.h"
 
 using namespace geodesk;
 
@@ -33,5 +34,6 @@ public:
 private:
     GEOSContextHandle_t context_ = nullptr;
     clarisma::TaggedPtr<GEOSGeometry,1> geom_;
+    CachedGeometryRef cached_;      // keeps a borrowed feature geometry alive
     Coordinate coord_;
 };
@@ -5,18 +5,25 @@
 #include <iostream>
 #include "python/Environment.h"
 #include "python/feature/PyFeature.h"
+#include "python/feature/PyTagAccessor.h"
 #include "python/feature/PyTags.h"
+#include "python/feature/StringObjectCache.h"
 #include "python/format/PyFormatter.h"
 #include "python/format/PyMap.h"
 #include "python/geom/PyBox.h"
 #include "python/geom/PyCoordinate.h"
 #include "python/geom/PyMercator.h"
 // #include "python/geom/PyRTree.h"
+#include "python/query/PyAsyncQuery.h"
+#include "python/query/PyFeatureSet.h"
 #include "python/query/PyFeatures.h"
 #include "python/query/PyQuery.h"
 #include "python/query/PyTile.h"
+#include "python/query/StoreState.h"
 #include "python/util/PyBinder.h"
 #include "python/util/PyFastMethod.h"
+#include "python/util/PyNumArray.h"
+#include "python/util/WorkPool.h"
 #include <clarisma/util/log.h>
 
 static PyMethodDef GEODESK_METHODS[] = 
@@ -37,98 +44,156 @@ static PyMethodDef GEODESK_METHODS[] =
     "Computes the distance between two geometric objects"},
     { "buffer", (PyCFunction)PyMercator::buffer, METH_VARARGS | METH_KEYWORDS,
 "Computes the buffer of a geometric object"},
+    { "set_thread_pool", (PyCFunction)WorkPool::set_thread_pool, METH_VARARGS | METH_KEYWORDS,
+    "Sets the number of worker threads (and optionally their CPU affinity) that process "
+    "query results for all feature stores (query execution itself uses libgeodesk's own threads)"},
+    { "_restore_feature", (PyCFunction)PyFeature::restore, METH_VARARGS,
+    "Recreates a pickled Feature"},
+    { "_restore_features", (PyCFunction)PyFeatures::restore, METH_VARARGS,
+    "Recreates a pickled Features object"},
+    { "_tile_features", (PyCFunction)PyFeatures::tileFeatures, METH_VARARGS,
+    "Restricts a selection to the features of a single tile"},
+    { "_shutdown", (PyCFunction)PyAsyncQuery::shutdown, METH_NOARGS,
+    "Stops the threads of pending async queries (called at exit)"},
     {NULL, NULL, 0, NULL}        /* Sentinel */
 };
 
-static PyModuleDef GEODESK_MODULE =
+/**
+ * Per-module state. Each time the module is initialized (e.g. if it is
+ * loaded again via importlib), it gets its own module object.
+ */
+struct ModuleState
 {
-    PyModuleDef_HEAD_INIT,
-    "geodesk",
-    "GeoDesk Query Engine",
-    -1,                         // TODO: use this for size of module state
-    GEODESK_METHODS,
-    nullptr, nullptr, nullptr, nullptr
+    PyObject* queryError;
+    bool live;      // counted in moduleInstances
 };
 
-int createPrivateType(PyObject* module, PyTypeObject* type)
+/// The number of module instances that have been initialized, but not
+/// yet freed; once the last one is gone, the Python objects cached for
+/// the feature stores are released (they are process-wide)
+static int moduleInstances = 0;
+
+static ModuleState* getModuleState(PyObject* module)
 {
-    if (PyType_Ready(type) < 0)
-    {
-        Py_DECREF(module);
-        return -1;
-    }
+    return (ModuleState*)PyModule_GetState(module);
+}
+
+static int traverseModule(PyObject* module, visitproc visit, void* arg)
+{
+    ModuleState* state = getModuleState(module);
+    Py_VISIT(state->queryError);
     return 0;
 }
 
-// TODO: Could use PyModule_AddType(PyObject *module, PyTypeObject *type) since 3.10
-int createPublicType(PyObject* module, const char* name, PyTypeObject* type)
+static int clearModule(PyObject* module)
 {
-    if (PyType_Ready(type) < 0)
+    ModuleState* state = getModuleState(module);
+    Py_CLEAR(state->queryError);
+    return 0;
+}
+
+static void freeModule(void* module)
+{
+    clearModule((PyObject*)module);
+    ModuleState* state = getModuleState((PyObject*)module);
+    if (state->live)
     {
-        Py_DECREF(module);
-        return -1;
+        state->live = false;
+        if (--moduleInstances == 0)
+        {
+            PyFeatures::clearStoreCache();
+            StoreState::clearCaches();
+        }
     }
-    if (PyModule_AddObject(module, name, (PyObject*)type) < 0) 
-    {
-        Py_DECREF(type);
-        Py_DECREF(module);
-        return -1;
-    }
-    return 0;
+}
+
+int createPrivateType(PyObject* module, PyTypeObject* type)
+{
+    // PyType_Ready() is a no-op if another module instance has
+    // already readied the type
+    return PyType_Ready(type);
+}
+
+int createPublicType(PyObject* module, const char* name, PyTypeObject* type)
+{
+    if (PyType_Ready(type) < 0) return -1;
+    return PyModule_AddObjectRef(module, name, (PyObject*)type);
 }
 
 #ifdef GEODESK_TEST_PERFORMANCE
 volatile uint32_t performance_blackhole;
 #endif 
 
-extern "C" PyMODINIT_FUNC PyInit__geodesk()
+/**
+ * Initializes a module object (multi-phase initialization). On error,
+ * we just return -1; the interpreter disposes of the module.
+ */
+static int execModule(PyObject* module)
 {
 #ifdef GEODESK_TEST_PERFORMANCE
     printf("\n=== Test build, not for release ===\n");
 #endif
-    LOG("PyInit_geodesk...");
+    LOG("Initializing geodesk module...");
     
-
-    if (Environment::get().init() < 0) return NULL;
-
-    PyObject* module = PyModule_Create(&GEODESK_MODULE);
-    if (!module) return nullptr;
-    if(createPublicType(module, "Box", &PyBox::TYPE) < 0) return nullptr;
-    if (createPublicType(module, "Coordinate", &PyCoordinate::TYPE) < 0) return nullptr;
-    if (createPublicType(module, "Feature", &PyFeature::TYPE) < 0) return nullptr;
-    if (createPublicType(module, "Features", &PyFeatures::TYPE) < 0) return nullptr;
-    if (createPublicType(module, "Map", &PyMap::TYPE) < 0) return nullptr;
-    // if (createPublicType(module, "RTree", &PyRTree::TYPE) < 0) return nullptr;
-
-    if (createPrivateType(module, &PyQuery::TYPE) < 0) return nullptr;
-    if (createPrivateType(module, &PyTags::TYPE) < 0) return nullptr;
-    if (createPrivateType(module, &PyTagIterator::TYPE) < 0) return nullptr;
-    if (createPrivateType(module, &PyMemberIterator::TYPE) < 0) return nullptr;
-    if (createPrivateType(module, &PyWayNodeIterator::TYPE) < 0) return nullptr;
-    if (createPrivateType(module, &PyParentRelationIterator::TYPE) < 0) return nullptr;
-    if (createPrivateType(module, &PyNodeParentIterator::TYPE) < 0) return nullptr;
-    if (createPrivateType(module, &PyAnonymousNode::TYPE) < 0) return nullptr;
-    if (createPrivateType(module, &PyFastMethod::TYPE) < 0) return nullptr;
-    if (createPrivateType(module, &PyBinder::TYPE) < 0) return nullptr;
-    if (createPrivateType(module, &PyFormatter::TYPE) < 0) return nullptr;
-    if (createPrivateType(module, &PyTile::TYPE) < 0) return nullptr;
-    // if (createPrivateType(module, &PyRTreeQuery::TYPE) < 0) return nullptr;
+    Environment& env = Environment::get();
+    if (env.init() < 0) return -1;
+    ModuleState* state = getModuleState(module);
+    state->live = true;
+    moduleInstances++;
+
+    if(createPublicType(module, "Box", &PyBox::TYPE) < 0) return -1;
+    if (createPublicType(module, "Coordinate", &PyCoordinate::TYPE) < 0) return -1;
+    if (createPublicType(module, "Feature", &PyFeature::TYPE) < 0) return -1;
+    if (createPublicType(module, "Features", &PyFeatures::TYPE) < 0) return -1;
+    if (createPublicType(module, "FeatureSet", &PyFeatureSet::TYPE) < 0) return -1;
+    if (createPublicType(module, "Map", &PyMap::TYPE) < 0) return -1;
+    // if (createPublicType(module, "RTree", &PyRTree::TYPE) < 0) return -1;
+
+    if (createPrivateType(module, &PyQuery::TYPE) < 0) return -1;
+    if (createPrivateType(module, &PyAsyncQuery::TYPE) < 0) return -1;
+    if (createPrivateType(module, &PyTags::TYPE) < 0) return -1;
+    if (createPrivateType(module, &PyTagIterator::TYPE) < 0) return -1;
+    if (createPrivateType(module, &PyMemberIterator::TYPE) < 0) return -1;
+    if (createPrivateType(module, &PyWayNodeIterator::TYPE) < 0) return -1;
+    if (createPrivateType(module, &PyParentRelationIterator::TYPE) < 0) return -1;
+    if (createPrivateType(module, &PyNodeParentIterator::TYPE) < 0) return -1;
+    if (createPrivateType(module, &PyAnonymousNode::TYPE) < 0) return -1;
+    if (createPrivateType(module, &PyFastMethod::TYPE) < 0) return -1;
+    if (createPrivateType(module, &PyBinder::TYPE) < 0) return -1;
+    if (createPrivateType(module, &PyFormatter::TYPE) < 0) return -1;
+    if (createPrivateType(module, &PyTile::TYPE) < 0) return -1;
+    if (createPrivateType(module, &PyNumArray::TYPE) < 0) return -1;
+    if (createPrivateType(module, &PyStringTable::TYPE) < 0) return -1;
+    if (createPrivateType(module, &PyTagAccessor::TYPE) < 0) return -1;
+    if (createPrivateType(module, &PyFeatureSetIterator::TYPE) < 0) return -1;
+    // if (createPrivateType(module, &PyRTreeQuery::TYPE) < 0) return -1;
 
     Python::createDirMethod(&PyFeatures::TYPE, (PyCFunctionWithKeywords)&PyFeatures::dir);
 
-    PyObject* exc = PyErr_NewException("geodesk.QueryError", NULL, NULL);
-    if (!exc)
+    // QueryError is created once per process (Environment raises it from
+    // code that has no access to the module), and shared by all modules
+    state->queryError = Python::newRef(env.queryException());
+    if (PyModule_AddObjectRef(module, "QueryError", env.queryException()) < 0)
     {
-        Py_DECREF(module);
-        return nullptr;
+        return -1;
     }
-    if (PyModule_AddObject(module, "QueryError", exc) < 0)
+
+    // Feeder threads of async queries must be joined before the
+    // interpreter finalizes (it is idempotent, so it doesn't matter
+    // if the module is initialized more than once)
+    PyObject* shutdown = PyObject_GetAttrString(module, "_shutdown");
+    if (!shutdown) return -1;
+    PyObject* atexit = PyImport_ImportModule("atexit");
+    if (!atexit)
     {
-        Py_DECREF(exc);
-        Py_DECREF(module);
-        return nullptr;
+        Py_DECREF(shutdown);
+        return -1;
     }
-    Environment::get().queryException_ = exc;
+    PyObject* result = PyObject_CallMethod(atexit, "register", "O", shutdown);
+    Py_DECREF(atexit);
+    Py_DECREF(shutdown);
+    if (!result) return -1;
+    Py_DECREF(result);
 
     /*
     PyObject* submodule = PyInit_geodesk_filter();
@@ -148,8 +213,43 @@ extern "C" PyMODINIT_FUNC PyInit__geodesk()
     PyModule_AddObject(module, "__package__", PyUnicode_FromString("geodesk"));
     */
 
-    LOG("Successfully created geodesk module.");
+    LOG("Successfully initialized geodesk module.");
+    return 0;
+}
 
-    return module;
+static PyModuleDef_Slot GEODESK_SLOTS[] =
+{
+    { Py_mod_exec, (void*)execModule },
+#if PY_VERSION_HEX >= 0x030C0000
+    // Sub-interpreters may import the module only if they share the
+    // main interpreter's GIL (like the legacy sub-interpreters of
+    // mod_wsgi and other embedders): the types and QueryError are
+    // static, and Python objects (strings, empty selections, stores
+    // of pickled features) are cached per process or per FeatureStore
+    { Py_mod_multiple_interpreters, Py_MOD_MULTIPLE_INTERPRETERS_SUPPORTED },
+#endif
+    // We don't support free-threaded builds (and hence don't declare
+    // Py_mod_gil): libgeodesk lazily creates the Python objects it
+    // caches in a FeatureStore (empty selections and tags, string
+    // objects) without any locking
+    { 0, nullptr }
+};
+
+static PyModuleDef GEODESK_MODULE =
+{
+    PyModuleDef_HEAD_INIT,
+    "geodesk",
+    "GeoDesk Query Engine",
+    sizeof(ModuleState),
+    GEODESK_METHODS,
+    GEODESK_SLOTS,
+    traverseModule,
+    clearModule,
+    freeModule
+};
+
+extern "C" PyMODINIT_FUNC PyInit__geodesk()
+{
+    return PyModuleDef_Init(&GEODESK_MODULE);
 }
 
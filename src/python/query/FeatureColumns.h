@@ -0,0 +1,99 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#pragma once
+
+#include <Python.h>
+#include <algorithm>
+#include <vector>
+#include <geodesk/feature/FeaturePtr.h>
+#include "python/util/PyNumArray.h"
+
+using namespace geodesk;
+
+/// \brief Collects one value per feature on the query workers (each
+/// into its own slot), for results that are returned as columns:
+/// a dict with the Arrays "type" (0 = node, 1 = way, 2 = relation)
+/// and "id", plus a "value" column of the caller's choosing.
+///
+/// The query returns features in no particular order, so the rows
+/// are sorted by type and ID, which makes the result deterministic.
+///
+template<typename T>
+class FeatureColumns
+{
+public:
+    struct Row
+    {
+        uint64_t id;
+        int type;
+        T value;
+
+        bool operator<(const Row& other) const
+        {
+            return type != other.type ? type < other.type : id < other.id;
+        }
+    };
+
+    explicit FeatureColumns(int slots) : slots_(slots) {}
+
+    /// Adds a value (may be called by the query workers)
+    void add(int slot, FeaturePtr feature, const T& value)
+    {
+        slots_[slot].push_back({ feature.id(), feature.typeCode(), value });
+    }
+
+    /// Merges the slots and sorts the rows; returns the sorted rows
+    const std::vector<Row>& rows()
+    {
+        if (rows_.empty())
+        {
+            size_t count = 0;
+            for (const std::vector<Row>& slot : slots_) count += slot.size();
+            rows_.reserve(count);
+            for (std::vector<Row>& slot : slots_)
+            {
+                rows_.insert(rows_.end(), slot.begin(), slot.end());
+                std::vector<Row>().swap(slot);
+            }
+            std::sort(rows_.begin(), rows_.end());
+        }
+        return rows_;
+    }
+
+    /// Creates the result dict, using the given "value" column (whose
+    /// items must be in the order of rows()). Steals the reference to
+    /// `values`; returns NULL (with a Python exception set) on error.
+    PyObject* toDict(PyObject* values)
+    {
+        if (!values) return NULL;
+        const std::vector<Row>& sorted = rows();
+        PyNumArray* types = PyNumArray::create('B', sorted.size());
+        PyNumArray* ids = types ? PyNumArray::create('q', sorted.size()) : nullptr;
+        PyObject* dict = ids ? PyDict_New() : nullptr;
+        if (dict)
+        {
+            uint8_t* pTypes = types->values<uint8_t>();
+            int64_t* pIds = ids->values<int64_t>();
+            for (size_t i = 0; i < sorted.size(); i++)
+            {
+                pTypes[i] = static_cast<uint8_t>(sorted[i].type);
+                pIds[i] = static_cast<int64_t>(sorted[i].id);
+            }
+            if (PyDict_SetItemString(dict, "type", types) < 0 ||
+                PyDict_SetItemString(dict, "id", ids) < 0 ||
+                PyDict_SetItemString(dict, "value", values) < 0)
+            {
+                Py_CLEAR(dict);
+            }
+        }
+        Py_XDECREF(types);
+        Py_XDECREF(ids);
+        Py_DECREF(values);
+        return dict;
+    }
+
+private:
+    std::vector<std::vector<Row>> slots_;
+    std::vector<Row> rows_;
+};
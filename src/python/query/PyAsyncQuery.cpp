@@ -0,0 +1,596 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "PyAsyncQuery.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <geodesk/query/Query.h>
+#include "python/Environment.h"
+#include "python/feature/PyFeature.h"
+#include "python/util/util.h"
+#include "PyFeatures.h"
+#include "StoreState.h"
+
+/// \brief The state shared between a PyAsyncQuery (or the Future
+/// returned by acount()/afirst()) and the thread that drives the
+/// underlying Query.
+///
+/// The feed is refcounted, because either side may finish first:
+/// A consumer that abandons an `async for` merely cancels the feed
+/// and drops its reference (so it never blocks the event loop);
+/// the feeder thread's reference is held by AsyncFeeders, which
+/// lets go of it once it has joined the thread. All Python references
+/// held by the feed are released under the GIL, hence release() may
+/// only be called by a thread that holds the GIL.
+///
+class AsyncFeed
+{
+public:
+    enum Mode
+    {
+        ITER,
+        COUNT,
+        FIRST
+    };
+
+    AsyncFeed(PyFeatures* target, PyObject* loop, int mode) :
+        target_(target),
+        loop_(loop),
+        waiter_(nullptr),
+        refcount_(1),
+        mode_(mode),
+        storeState_(StoreState::of(target->store)),
+        maxBuffered_(target->bufferedResultLimit()),
+        batchSize_(std::min(MIN_BATCH_SIZE, maxBuffered_)),
+        count_(0),
+        waiting_(false),
+        done_(false),
+        cancelled_(false),
+        finished_(false)
+    {
+        Py_INCREF(target);
+        Py_INCREF(loop);
+    }
+
+    void addref() { refcount_.fetch_add(1, std::memory_order_relaxed); }
+
+    void release()
+    {
+        if (refcount_.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+    }
+
+    void cancel()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cancelled_ = true;
+        notFull_.notify_all();
+    }
+
+    /// Resolves the waiter (if any). Runs on the event loop's thread.
+    static PyObject* deliver(PyObject* capsule, PyObject* unused);
+
+    static const size_t MIN_BATCH_SIZE = 16;
+    static const size_t MAX_BATCH_SIZE = 1024;
+
+private:
+    ~AsyncFeed()
+    {
+        storeState_->removeBuffered(pending_.size());
+        Py_XDECREF(waiter_);
+        Py_DECREF(loop_);
+        Py_DECREF(target_);
+    }
+
+    void run();
+    void wakeConsumer();
+    PyObject* result();
+    static void releaseCapsule(PyObject* capsule);
+
+    static PyMethodDef DELIVER_METHOD;
+
+    PyFeatures* target_;
+    PyObject* loop_;
+    PyObject* waiter_;
+    std::atomic<int> refcount_;
+    int mode_;
+    StoreState* storeState_;
+    size_t maxBuffered_;         // the feeder pauses once reached
+    std::mutex mutex_;
+    std::condition_variable notFull_;
+    std::vector<FeaturePtr> pending_;
+    size_t batchSize_;
+    int64_t count_;
+    std::string error_;
+    bool waiting_;
+    bool done_;
+    bool cancelled_;
+    std::atomic<bool> finished_;    // set once run() has returned
+
+    friend class AsyncFeeders;
+    friend class PyAsyncQuery;
+};
+
+
+/// \brief Keeps track of the threads that run AsyncFeeds.
+///
+/// Feeder threads are joined rather than detached: finished threads
+/// are reaped whenever a new feed starts, and the module's atexit
+/// handler cancels the remaining feeds and joins their threads before
+/// the interpreter finalizes. Once shutdown has begun, feeders no
+/// longer try to take the GIL (which is unsafe while the interpreter
+/// is being torn down).
+///
+class AsyncFeeders
+{
+public:
+    /// Starts the feeder thread of a feed (must hold the GIL)
+    static void start(AsyncFeed* feed)
+    {
+        reap(false);
+        feed->addref();     // released once the thread has been joined
+        std::lock_guard<std::mutex> lock(mutex_);
+        feeders_.push_back({ std::thread(&AsyncFeed::run, feed), feed });
+    }
+
+    /// Cancels all feeds and joins their threads (must hold the GIL)
+    static void shutdown()
+    {
+        shuttingDown_.store(true, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (Feeder& feeder : feeders_) feeder.feed->cancel();
+        }
+        reap(true);
+    }
+
+    static bool isShuttingDown()
+    {
+        return shuttingDown_.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Feeder
+    {
+        std::thread thread;
+        AsyncFeed* feed;
+    };
+
+    /// Joins the threads that have finished (or all threads)
+    static void reap(bool all)
+    {
+        std::list<Feeder> reaped;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto it = feeders_.begin(); it != feeders_.end(); )
+            {
+                auto current = it++;
+                if (all || current->feed->finished_.load(std::memory_order_acquire))
+                {
+                    reaped.splice(reaped.end(), feeders_, current);
+                }
+            }
+        }
+        if (reaped.empty()) return;
+        // A feeder that is still running may need the GIL to wake
+        // its consumer before it can finish
+        Py_BEGIN_ALLOW_THREADS
+        for (Feeder& feeder : reaped) feeder.thread.join();
+        Py_END_ALLOW_THREADS
+        for (Feeder& feeder : reaped) feeder.feed->release();
+    }
+
+    static std::mutex mutex_;
+    static std::list<Feeder> feeders_;
+    static std::atomic<bool> shuttingDown_;
+};
+
+std::mutex AsyncFeeders::mutex_;
+std::list<AsyncFeeders::Feeder> AsyncFeeders::feeders_;
+std::atomic<bool> AsyncFeeders::shuttingDown_(false);
+
+
+void AsyncFeed::run()
+{
+    bool wake = false;
+    {
+        Query query(target_->store, target_->bounds, target_->acceptedTypes,
+            target_->matcher, target_->filter);
+        try
+        {
+            for (;;)
+            {
+                FeaturePtr feature = query.next();
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (cancelled_ || feature.isNull()) break;
+                if (mode_ == COUNT)
+                {
+                    count_++;
+                    continue;
+                }
+                pending_.push_back(feature);
+                storeState_->addBuffered(1);
+                if (mode_ == FIRST) break;
+                if (waiting_ && pending_.size() >= batchSize_)
+                {
+                    // Grow the batch as long as the consumer keeps up,
+                    // so it is woken less often
+                    batchSize_ = std::min(batchSize_ * 2,
+                        std::min(MAX_BATCH_SIZE, maxBuffered_));
+                    waiting_ = false;
+                    lock.unlock();
+                    wakeConsumer();
+                    continue;
+                }
+                if (pending_.size() >= maxBuffered_ && !cancelled_)
+                {
+                    // The consumer has fallen behind; pause until it
+                    // takes the pending results
+                    storeState_->countWait();
+                    while (pending_.size() >= maxBuffered_ && !cancelled_)
+                    {
+                        notFull_.wait(lock);
+                    }
+                }
+            }
+        }
+        catch (const std::exception& ex)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            error_ = ex.what();
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_ = true;
+        wake = !cancelled_ && (waiting_ || mode_ != ITER);
+        waiting_ = false;
+    }
+    // Deliver only once ~Query has run; for afirst(), this means
+    // we wait for the remaining tiles to be cancelled
+    if (wake) wakeConsumer();
+    finished_.store(true, std::memory_order_release);
+}
+
+
+void AsyncFeed::wakeConsumer()
+{
+    if (AsyncFeeders::isShuttingDown()) return;
+    PyGILState_STATE gil = PyGILState_Ensure();
+    addref();       // owned by the capsule
+    PyObject* capsule = PyCapsule_New(this, nullptr, releaseCapsule);
+    if (capsule)
+    {
+        PyObject* func = PyCFunction_New(&DELIVER_METHOD, capsule);
+        Py_DECREF(capsule);
+        if (func)
+        {
+            PyObject* res = PyObject_CallMethod(loop_, "call_soon_threadsafe", "O", func);
+            Py_XDECREF(res);
+            Py_DECREF(func);
+        }
+    }
+    else
+    {
+        release();
+    }
+    // If the loop has been closed in the meantime, there is nobody
+    // left to deliver to
+    Environment::clearAndLogException();
+    PyGILState_Release(gil);
+}
+
+
+void AsyncFeed::releaseCapsule(PyObject* capsule)
+{
+    ((AsyncFeed*)PyCapsule_GetPointer(capsule, nullptr))->release();
+}
+
+
+PyObject* AsyncFeed::result()
+{
+    if (!error_.empty())
+    {
+        PyErr_SetString(PyExc_RuntimeError, error_.c_str());
+        return NULL;
+    }
+    if (mode_ == COUNT) return PyLong_FromLongLong(count_);
+    if (pending_.empty()) Py_RETURN_NONE;
+    return PyFeature::create(target_->store, pending_[0], Py_None);
+}
+
+
+PyObject* AsyncFeed::deliver(PyObject* capsule, PyObject* unused)
+{
+    AsyncFeed* feed = (AsyncFeed*)PyCapsule_GetPointer(capsule, nullptr);
+    PyObject* waiter;
+    {
+        std::unique_lock<std::mutex> lock(feed->mutex_);
+        waiter = feed->waiter_;
+        feed->waiter_ = nullptr;
+    }
+    if (!waiter) Py_RETURN_NONE;
+
+    PyObject* res = PyObject_CallMethod(waiter, "done", NULL);
+    if (res == Py_False)
+    {
+        Py_DECREF(res);
+        if (feed->mode_ == ITER)
+        {
+            // The consumer picks up the batch itself
+            res = PyObject_CallMethod(waiter, "set_result", "O", Py_None);
+        }
+        else
+        {
+            PyObject* value = feed->result();
+            if (value)
+            {
+                res = PyObject_CallMethod(waiter, "set_result", "O", value);
+                Py_DECREF(value);
+            }
+            else
+            {
+                PyObject* type, * exc, * traceback;
+                PyErr_Fetch(&type, &exc, &traceback);
+                PyErr_NormalizeException(&type, &exc, &traceback);
+                res = PyObject_CallMethod(waiter, "set_exception", "O", exc);
+                Py_XDECREF(type);
+                Py_XDECREF(exc);
+                Py_XDECREF(traceback);
+            }
+        }
+    }
+    // (If the waiter is done, it has been cancelled by its owner)
+    Py_DECREF(waiter);
+    return res;
+}
+
+
+PyMethodDef AsyncFeed::DELIVER_METHOD =
+{
+    "_deliver", (PyCFunction)AsyncFeed::deliver, METH_NOARGS, nullptr
+};
+
+
+static PyObject* getRunningLoop()
+{
+    PyObject* asyncio = Environment::get().getAsyncioModule();
+    if (!asyncio) return NULL;
+    return PyObject_CallMethod(asyncio, "get_running_loop", NULL);
+}
+
+
+PyObject* PyAsyncQuery::create(PyFeatures* features)
+{
+    PyAsyncQuery* self = (PyAsyncQuery*)TYPE.tp_alloc(&TYPE, 0);
+    if (self)
+    {
+        Py_INCREF(features);
+        self->target = features;
+        self->feed = nullptr;
+        self->syncIter = nullptr;
+        new(&self->ready)std::vector<FeaturePtr>();
+        self->readyPos = 0;
+        if (features->selectionType != &PyFeatures::World::SUBTYPE)
+        {
+            // Other selections (members, way-nodes, parents) are
+            // resolved from the related feature's data and never wait
+            // for the query engine, so we simply drive their
+            // regular iterator
+            self->syncIter = features->selectionType->iter(features);
+            if (!self->syncIter)
+            {
+                Py_DECREF(self);
+                return NULL;
+            }
+        }
+    }
+    return self;
+}
+
+
+PyObject* PyAsyncQuery::count(PyFeatures* features)
+{
+    return createFuture(features, AsyncFeed::COUNT);
+}
+
+
+PyObject* PyAsyncQuery::first(PyFeatures* features)
+{
+    return createFuture(features, AsyncFeed::FIRST);
+}
+
+
+PyObject* PyAsyncQuery::createFuture(PyFeatures* features, int mode)
+{
+    PyObject* loop = getRunningLoop();
+    if (!loop) return NULL;
+    PyObject* future = PyObject_CallMethod(loop, "create_future", NULL);
+    if (future)
+    {
+        if (features->selectionType == &PyFeatures::World::SUBTYPE)
+        {
+            AsyncFeed* feed = new AsyncFeed(features, loop, mode);
+            Py_INCREF(future);
+            feed->waiter_ = future;
+            AsyncFeeders::start(feed);
+            feed->release();
+        }
+        else
+        {
+            PyObject* value = (mode == AsyncFeed::COUNT) ?
+                features->selectionType->count(features) :
+                features->getFirst(false /* mustHaveOne */, true /* mayHaveMore */);
+            PyObject* res = NULL;
+            if (value)
+            {
+                res = PyObject_CallMethod(future, "set_result", "O", value);
+                Py_DECREF(value);
+            }
+            if (!res)
+            {
+                Py_DECREF(future);
+                future = NULL;
+            }
+            Py_XDECREF(res);
+        }
+    }
+    Py_DECREF(loop);
+    return future;
+}
+
+
+bool PyAsyncQuery::start()
+{
+    PyObject* loop = getRunningLoop();
+    if (!loop) return false;
+    feed = new AsyncFeed(target, loop, AsyncFeed::ITER);
+    Py_DECREF(loop);
+    AsyncFeeders::start(feed);
+    return true;
+}
+
+
+PyObject* PyAsyncQuery::shutdown(PyObject* module, PyObject* unused)
+{
+    AsyncFeeders::shutdown();
+    Py_RETURN_NONE;
+}
+
+
+void PyAsyncQuery::dealloc(PyAsyncQuery* self)
+{
+    if (self->feed)
+    {
+        self->feed->storeState_->removeBuffered(self->ready.size());
+        self->feed->cancel();
+        self->feed->release();
+    }
+    Py_XDECREF(self->syncIter);
+    Py_DECREF(self->target);
+    self->ready.~vector();
+    Py_TYPE(self)->tp_free(self);
+}
+
+
+PyObject* PyAsyncQuery::self(PyAsyncQuery* self)
+{
+    return Python::newRef(self);
+}
+
+
+PyObject* PyAsyncQuery::returnFeature(FeaturePtr feature)
+{
+    PyObject* value = PyFeature::create(target->store, feature, Py_None);
+    if (!value) return NULL;
+    // Completing the awaitable means raising StopIteration with the
+    // result (safe to pass the value directly, since it is never a
+    // tuple or an exception)
+    PyErr_SetObject(PyExc_StopIteration, value);
+    Py_DECREF(value);
+    return NULL;
+}
+
+
+PyObject* PyAsyncQuery::next(PyAsyncQuery* self)
+{
+    if (self->readyPos < self->ready.size())
+    {
+        return self->returnFeature(self->ready[self->readyPos++]);
+    }
+    if (self->syncIter)
+    {
+        PyObject* value = PyIter_Next(self->syncIter);
+        if (value)
+        {
+            PyErr_SetObject(PyExc_StopIteration, value);
+            Py_DECREF(value);
+        }
+        else if (!PyErr_Occurred())
+        {
+            PyErr_SetNone(PyExc_StopAsyncIteration);
+        }
+        return NULL;
+    }
+    if (!self->feed && !self->start()) return NULL;
+
+    AsyncFeed* feed = self->feed;
+    PyObject* waiter = nullptr;
+    for (;;)
+    {
+        bool done;
+        {
+            std::unique_lock<std::mutex> lock(feed->mutex_);
+            done = feed->done_;
+            if (!feed->pending_.empty())
+            {
+                // The previous batch has been handed to Python
+                feed->storeState_->removeBuffered(self->ready.size());
+                self->ready.clear();
+                self->ready.swap(feed->pending_);
+                self->readyPos = 0;
+                feed->notFull_.notify_one();
+            }
+            else if (!done && waiter)
+            {
+                Python::set(&feed->waiter_, waiter);
+                feed->waiting_ = true;
+                break;
+            }
+        }
+        Py_XDECREF(waiter);
+        waiter = nullptr;
+        if (self->readyPos < self->ready.size())
+        {
+            return self->returnFeature(self->ready[self->readyPos++]);
+        }
+        if (done)
+        {
+            if (!feed->error_.empty())
+            {
+                PyErr_SetString(PyExc_RuntimeError, feed->error_.c_str());
+            }
+            else
+            {
+                PyErr_SetNone(PyExc_StopAsyncIteration);
+            }
+            return NULL;
+        }
+        // Nothing available yet: create a future to wait on (outside of
+        // the lock), then check again before we hand it to the feeder
+        waiter = PyObject_CallMethod(feed->loop_, "create_future", NULL);
+        if (!waiter) return NULL;
+    }
+
+    // Yield the future to the Task that runs the coroutine; this is
+    // what `await future` does under the hood
+    if (PyObject_SetAttrString(waiter, "_asyncio_future_blocking", Py_True) < 0)
+    {
+        Py_DECREF(waiter);
+        return NULL;
+    }
+    return waiter;
+}
+
+
+PyAsyncMethods PyAsyncQuery::ASYNC_METHODS =
+{
+    .am_await = (unaryfunc)PyAsyncQuery::self,
+    .am_aiter = (unaryfunc)PyAsyncQuery::self,
+    .am_anext = (unaryfunc)PyAsyncQuery::self,
+};
+
+
+PyTypeObject PyAsyncQuery::TYPE =
+{
+    .tp_name = "geodesk.AsyncQuery",
+    .tp_basicsize = sizeof(PyAsyncQuery),
+    .tp_dealloc = (destructor)dealloc,
+    .tp_as_async = &ASYNC_METHODS,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Asynchronous query iterator",
+    .tp_iternext = (iternextfunc)next,
+};
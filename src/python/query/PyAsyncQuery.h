@@ -0,0 +1,64 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#pragma once
+
+#include <Python.h>
+#include <vector>
+#include <geodesk/feature/FeaturePtr.h>
+
+using namespace geodesk;
+class AsyncFeed;
+class PyFeatures;
+
+/// \brief Asynchronous iterator (and awaitable) over the results of a
+/// query, returned by Features.aiter().
+///
+/// The query runs on a feeder thread (see AsyncFeed), which waits for
+/// results without holding the GIL. Results are handed over in batches;
+/// the feeder wakes the event loop (via `loop.call_soon_threadsafe()`,
+/// which writes to the loop's self-pipe) only if a coroutine is waiting
+/// for a result, so a consumer that keeps up with the engine is woken
+/// once per batch rather than once per feature.
+///
+/// The object is its own awaitable: `__anext__` returns `self`, and
+/// iterating the awaitable either completes immediately (if a feature
+/// is already available) or yields a future that the feeder resolves
+/// once the next batch (or the end of the query) arrives.
+///
+class PyAsyncQuery : public PyObject
+{
+public:
+    PyFeatures* target;
+    AsyncFeed* feed;                // null until first use, or in sync mode
+    PyObject* syncIter;             // for selections that never block
+    std::vector<FeaturePtr> ready;  // batch taken over from the feeder
+    size_t readyPos;
+
+    static PyTypeObject TYPE;
+    static PyAsyncMethods ASYNC_METHODS;
+
+    /// Creates the async iterator for Features.aiter()
+    static PyObject* create(PyFeatures* features);
+
+    /// Counts the features on the feeder thread and returns an
+    /// asyncio Future for the result (Features.acount())
+    static PyObject* count(PyFeatures* features);
+
+    /// Returns an asyncio Future for the first feature, or None if
+    /// the selection is empty (Features.afirst())
+    static PyObject* first(PyFeatures* features);
+
+    /// Cancels the running queries and joins their feeder threads;
+    /// registered with `atexit` when the module is initialized
+    static PyObject* shutdown(PyObject* module, PyObject* unused);
+
+    static void dealloc(PyAsyncQuery* self);
+    static PyObject* self(PyAsyncQuery* self);
+    static PyObject* next(PyAsyncQuery* self);
+
+private:
+    static PyObject* createFuture(PyFeatures* features, int mode);
+    bool start();
+    PyObject* returnFeature(FeaturePtr feature);
+};
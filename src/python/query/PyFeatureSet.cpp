@@ -0,0 +1,595 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "PyFeatureSet.h"
+#include <new>
+#include <utility>
+#include <geodesk/feature/NodePtr.h>
+#include <geodesk/query/Query.h>
+#include "python/feature/PyFeature.h"
+#include "python/query/PyFeatures.h"
+#include "python/query/StoreState.h"
+#include "python/util/util.h"
+
+namespace {
+
+uint64_t mix(uint64_t x)
+{
+    // splitmix64 finalizer
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+const uint32_t MIN_CAPACITY = 16;
+
+/// \brief Accepts the features whose typed IDs are in a snapshot of a
+/// FeatureSet (only the IDs that belong to the store being queried).
+///
+/// The IDs are kept in their own open-addressing table, so accept()
+/// only touches a single cache line in the common case. Since the
+/// type occupies the lowest 2 bits of a typed ID (and is never 3),
+/// a value with all bits set can't be a typed ID and marks empty slots.
+///
+class FeatureSetFilter : public Filter
+{
+public:
+    FeatureSetFilter(size_t capacity, FeatureTypes types, const Box& bounds) :
+        table_(capacity, EMPTY),
+        mask_(capacity - 1)
+    {
+        acceptedTypes_ = types;
+        bounds_ = bounds;
+    }
+
+    void add(uint64_t typedId)
+    {
+        size_t i = mix(typedId) & mask_;
+        while (table_[i] != EMPTY) i = (i + 1) & mask_;
+        table_[i] = typedId;
+    }
+
+    bool accept(FeatureStore* store, FeaturePtr feature, FastFilterHint fast) const override
+    {
+        uint64_t typedId = feature.typedId();
+        for (size_t i = mix(typedId) & mask_; ; i = (i + 1) & mask_)
+        {
+            uint64_t id = table_[i];
+            if (id == typedId) return true;
+            if (id == EMPTY) return false;
+        }
+    }
+
+private:
+    static constexpr uint64_t EMPTY = ~0ULL;
+
+    std::vector<uint64_t> table_;
+    size_t mask_;
+};
+
+}
+
+PyFeatureSet* PyFeatureSet::createEmpty()
+{
+    PyFeatureSet* self = (PyFeatureSet*)TYPE.tp_alloc(&TYPE, 0);
+    if (self)
+    {
+        self->entries = nullptr;
+        self->capacity = 0;
+        self->count = 0;
+        self->version = 0;
+        new(&self->stores) std::vector<FeatureStore*>();
+    }
+    return self;
+}
+
+PyObject* PyFeatureSet::createNew(PyTypeObject* type, PyObject* args, PyObject* kwargs)
+{
+    static const char* KEYWORDS[] = { "features", NULL };
+    PyObject* features = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O:FeatureSet",
+        const_cast<char**>(KEYWORDS), &features))
+    {
+        return NULL;
+    }
+    PyFeatureSet* self = createEmpty();
+    if (self && features && !self->addAll(features))
+    {
+        Py_CLEAR(self);
+    }
+    return self;
+}
+
+void PyFeatureSet::dealloc(PyFeatureSet* self)
+{
+    delete[] self->entries;
+    for (FeatureStore* store : self->stores) StoreState::release(store);
+    self->stores.~vector();
+    Py_TYPE(self)->tp_free(self);
+}
+
+uint32_t PyFeatureSet::slotOf(uint32_t storeIndex, uint64_t typedId) const
+{
+    return static_cast<uint32_t>(mix(typedId ^
+        (static_cast<uint64_t>(storeIndex) << 56))) & (capacity - 1);
+}
+
+int PyFeatureSet::findStore(FeatureStore* store) const
+{
+    for (size_t i = 0; i < stores.size(); i++)
+    {
+        if (stores[i] == store) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+uint32_t PyFeatureSet::storeIndex(FeatureStore* store)
+{
+    int index = findStore(store);
+    if (index >= 0) return static_cast<uint32_t>(index);
+    store->addref();
+    stores.push_back(store);
+    return static_cast<uint32_t>(stores.size() - 1);
+}
+
+const PyFeatureSet::Entry* PyFeatureSet::find(uint32_t storeIndex, uint64_t typedId) const
+{
+    if (count == 0) return nullptr;
+    uint32_t mask = capacity - 1;
+    for (uint32_t i = slotOf(storeIndex, typedId); ; i = (i + 1) & mask)
+    {
+        const Entry& entry = entries[i];
+        if (entry.feature.isNull()) return nullptr;
+        if (entry.typedId == typedId && entry.store == storeIndex) return &entry;
+    }
+}
+
+bool PyFeatureSet::resize(uint32_t newCapacity)
+{
+    Entry* newEntries = new(std::nothrow) Entry[newCapacity];
+    if (!newEntries)
+    {
+        PyErr_NoMemory();
+        return false;
+    }
+    Entry* oldEntries = entries;
+    uint32_t oldCapacity = capacity;
+    entries = newEntries;
+    capacity = newCapacity;
+    uint32_t mask = capacity - 1;
+    for (uint32_t i = 0; i < oldCapacity; i++)
+    {
+        const Entry& entry = oldEntries[i];
+        if (entry.feature.isNull()) continue;
+        uint32_t slot = slotOf(entry.store, entry.typedId);
+        while (!entries[slot].feature.isNull()) slot = (slot + 1) & mask;
+        entries[slot] = entry;
+    }
+    delete[] oldEntries;
+    return true;
+}
+
+int PyFeatureSet::insertEntry(uint32_t storeIndex, uint64_t typedId, FeaturePtr feature)
+{
+    if (find(storeIndex, typedId)) return 0;
+    // Keep the load factor below 2/3, so probe sequences stay short
+    // (and there is always an empty slot to end them)
+    if ((static_cast<uint64_t>(count) + 1) * 3 > static_cast<uint64_t>(capacity) * 2)
+    {
+        if (capacity >= 0x80000000)
+        {
+            PyErr_SetString(PyExc_OverflowError, "FeatureSet is too large");
+            return -1;
+        }
+        if (!resize(capacity ? capacity * 2 : MIN_CAPACITY)) return -1;
+    }
+    uint32_t mask = capacity - 1;
+    uint32_t slot = slotOf(storeIndex, typedId);
+    while (!entries[slot].feature.isNull()) slot = (slot + 1) & mask;
+    entries[slot] = { typedId, feature, storeIndex };
+    count++;
+    version++;
+    return 1;
+}
+
+bool PyFeatureSet::removeEntry(uint32_t storeIndex, uint64_t typedId)
+{
+    const Entry* entry = find(storeIndex, typedId);
+    if (!entry) return false;
+
+    // Backward-shift deletion: move up any entries of the probe
+    // sequence that would otherwise become unreachable (this way,
+    // we don't need tombstones)
+    uint32_t mask = capacity - 1;
+    uint32_t hole = static_cast<uint32_t>(entry - entries);
+    for (uint32_t i = (hole + 1) & mask; !entries[i].feature.isNull(); i = (i + 1) & mask)
+    {
+        uint32_t home = slotOf(entries[i].store, entries[i].typedId);
+        bool reachable = hole < i ? (home > hole && home <= i) : (home > hole || home <= i);
+        if (!reachable)
+        {
+            entries[hole] = entries[i];
+            hole = i;
+        }
+    }
+    entries[hole].feature = FeaturePtr();
+    count--;
+    version++;
+    return true;
+}
+
+int PyFeatureSet::insert(FeatureStore* store, FeaturePtr feature)
+{
+    return insertEntry(storeIndex(store), feature.typedId(), feature);
+}
+
+bool PyFeatureSet::containsId(FeatureStore* store, uint64_t typedId) const
+{
+    int index = findStore(store);
+    return index >= 0 && find(static_cast<uint32_t>(index), typedId) != nullptr;
+}
+
+bool PyFeatureSet::addAll(PyObject* obj)
+{
+    PyTypeObject* type = Py_TYPE(obj);
+    if (type == &PyFeature::TYPE)
+    {
+        PyFeature* feature = (PyFeature*)obj;
+        return insert(feature->store, feature->feature) >= 0;
+    }
+    if (type == &PyFeatures::TYPE)
+    {
+        PyFeatures* features = (PyFeatures*)obj;
+        if (features->selectionType == &PyFeatures::World::SUBTYPE)
+        {
+            // Add the results of the query directly, without creating
+            // a Feature object for each
+            std::vector<FeaturePtr> results;
+            Py_BEGIN_ALLOW_THREADS
+            {
+                Query query(features->store, features->bounds, features->acceptedTypes,
+                    features->matcher, features->filter);
+                for (;;)
+                {
+                    FeaturePtr feature = query.next();
+                    if (feature.isNull()) break;
+                    results.push_back(feature);
+                }
+            }
+            Py_END_ALLOW_THREADS
+            uint32_t index = storeIndex(features->store);
+            for (FeaturePtr feature : results)
+            {
+                if (insertEntry(index, feature.typedId(), feature) < 0) return false;
+            }
+            return true;
+        }
+    }
+
+    PyObject* iter = PyObject_GetIter(obj);
+    if (!iter) return false;
+    PyObject* item;
+    while ((item = PyIter_Next(iter)))
+    {
+        int res;
+        if (Py_TYPE(item) == &PyFeature::TYPE)
+        {
+            PyFeature* feature = (PyFeature*)item;
+            res = insert(feature->store, feature->feature);
+        }
+        else
+        {
+            PyErr_Format(PyExc_TypeError, "Expected Feature (instead of %s)",
+                Py_TYPE(item)->tp_name);
+            res = -1;
+        }
+        Py_DECREF(item);
+        if (res < 0)
+        {
+            Py_DECREF(iter);
+            return false;
+        }
+    }
+    Py_DECREF(iter);
+    return !PyErr_Occurred();
+}
+
+template<typename Pred>
+bool PyFeatureSet::addEntries(const PyFeatureSet* other, Pred pred)
+{
+    for (uint32_t i = 0; i < other->capacity; i++)
+    {
+        const Entry& entry = other->entries[i];
+        if (entry.feature.isNull()) continue;
+        FeatureStore* store = other->stores[entry.store];
+        if (!pred(store, entry)) continue;
+        if (insertEntry(storeIndex(store), entry.typedId, entry.feature) < 0) return false;
+    }
+    return true;
+}
+
+const Filter* PyFeatureSet::createFilter(FeatureStore* store, const Box& bounds) const
+{
+    int index = findStore(store);
+    if (index < 0) return nullptr;
+    size_t n = 0;
+    Box featureBounds;
+    uint32_t types = 0;
+    for (uint32_t i = 0; i < capacity; i++)
+    {
+        const Entry& entry = entries[i];
+        if (entry.feature.isNull() || entry.store != static_cast<uint32_t>(index)) continue;
+        FeaturePtr feature = entry.feature;
+        if (feature.isNode())
+        {
+            featureBounds.expandToInclude(NodePtr(feature).xy());
+            types |= FeatureTypes::NODES;
+        }
+        else
+        {
+            featureBounds.expandToInclude(feature.bounds());
+            types |= feature.isWay() ? FeatureTypes::WAYS : FeatureTypes::RELATIONS;
+        }
+        n++;
+    }
+    if (n == 0) return nullptr;
+
+    // Restricting the query to the bounds of the features means
+    // that only the tiles that contain them are searched
+    Box filterBounds = Box::simpleIntersection(bounds, featureBounds);
+    if (filterBounds.isEmpty()) return nullptr;
+
+    size_t tableSize = MIN_CAPACITY;
+    while (tableSize < n * 2) tableSize *= 2;
+    FeatureSetFilter* filter = new FeatureSetFilter(tableSize, types, filterBounds);
+    for (uint32_t i = 0; i < capacity; i++)
+    {
+        const Entry& entry = entries[i];
+        if (entry.feature.isNull() || entry.store != static_cast<uint32_t>(index)) continue;
+        filter->add(entry.typedId);
+    }
+    return filter;
+}
+
+PyObject* PyFeatureSet::iter(PyFeatureSet* self)
+{
+    return PyFeatureSetIterator::create(self);
+}
+
+Py_ssize_t PyFeatureSet::len(PyFeatureSet* self)
+{
+    return self->count;
+}
+
+int PyFeatureSet::isTrue(PyFeatureSet* self)
+{
+    return self->count != 0;
+}
+
+int PyFeatureSet::contains(PyFeatureSet* self, PyObject* item)
+{
+    if (Py_TYPE(item) != &PyFeature::TYPE) return 0;
+    PyFeature* feature = (PyFeature*)item;
+    Python::CriticalSection lock(self);
+    return self->containsId(feature->store, feature->feature.typedId());
+}
+
+PyObject* PyFeatureSet::repr(PyFeatureSet* self)
+{
+    return PyUnicode_FromFormat("<FeatureSet with %u feature%s>",
+        self->count, self->count == 1 ? "" : "s");
+}
+
+PyObject* PyFeatureSet::union_(PyObject* a, PyObject* b)
+{
+    if (Py_TYPE(a) != &TYPE || Py_TYPE(b) != &TYPE) Py_RETURN_NOTIMPLEMENTED;
+    PyFeatureSet* result = createEmpty();
+    if (!result) return NULL;
+    auto all = [](FeatureStore*, const Entry&) { return true; };
+    if (!result->addEntries((PyFeatureSet*)a, all) ||
+        !result->addEntries((PyFeatureSet*)b, all))
+    {
+        Py_CLEAR(result);
+    }
+    return result;
+}
+
+PyObject* PyFeatureSet::intersection(PyObject* a, PyObject* b)
+{
+    if (Py_TYPE(a) != &TYPE || Py_TYPE(b) != &TYPE) Py_RETURN_NOTIMPLEMENTED;
+    PyFeatureSet* smaller = (PyFeatureSet*)a;
+    PyFeatureSet* larger = (PyFeatureSet*)b;
+    if (smaller->count > larger->count) std::swap(smaller, larger);
+    PyFeatureSet* result = createEmpty();
+    if (!result) return NULL;
+    if (!result->addEntries(smaller, [larger](FeatureStore* store, const Entry& entry)
+        {
+            return larger->containsId(store, entry.typedId);
+        }))
+    {
+        Py_CLEAR(result);
+    }
+    return result;
+}
+
+PyObject* PyFeatureSet::difference(PyObject* a, PyObject* b)
+{
+    if (Py_TYPE(a) != &TYPE || Py_TYPE(b) != &TYPE) Py_RETURN_NOTIMPLEMENTED;
+    PyFeatureSet* other = (PyFeatureSet*)b;
+    PyFeatureSet* result = createEmpty();
+    if (!result) return NULL;
+    if (!result->addEntries((PyFeatureSet*)a, [other](FeatureStore* store, const Entry& entry)
+        {
+            return !other->containsId(store, entry.typedId);
+        }))
+    {
+        Py_CLEAR(result);
+    }
+    return result;
+}
+
+PyObject* PyFeatureSet::symmetricDifference(PyObject* a, PyObject* b)
+{
+    if (Py_TYPE(a) != &TYPE || Py_TYPE(b) != &TYPE) Py_RETURN_NOTIMPLEMENTED;
+    PyFeatureSet* setA = (PyFeatureSet*)a;
+    PyFeatureSet* setB = (PyFeatureSet*)b;
+    PyFeatureSet* result = createEmpty();
+    if (!result) return NULL;
+    if (!result->addEntries(setA, [setB](FeatureStore* store, const Entry& entry)
+            {
+                return !setB->containsId(store, entry.typedId);
+            }) ||
+        !result->addEntries(setB, [setA](FeatureStore* store, const Entry& entry)
+            {
+                return !setA->containsId(store, entry.typedId);
+            }))
+    {
+        Py_CLEAR(result);
+    }
+    return result;
+}
+
+PyObject* PyFeatureSet::add(PyFeatureSet* self, PyObject* arg)
+{
+    if (Py_TYPE(arg) != &PyFeature::TYPE)
+    {
+        PyErr_Format(PyExc_TypeError, "Expected Feature (instead of %s)",
+            Py_TYPE(arg)->tp_name);
+        return NULL;
+    }
+    PyFeature* feature = (PyFeature*)arg;
+    Python::CriticalSection lock(self);
+    if (self->insert(feature->store, feature->feature) < 0) return NULL;
+    Py_RETURN_NONE;
+}
+
+PyObject* PyFeatureSet::clear(PyFeatureSet* self, PyObject* unused)
+{
+    Python::CriticalSection lock(self);
+    delete[] self->entries;
+    self->entries = nullptr;
+    self->capacity = 0;
+    self->count = 0;
+    self->version++;
+    for (FeatureStore* store : self->stores) StoreState::release(store);
+    self->stores.clear();
+    Py_RETURN_NONE;
+}
+
+PyObject* PyFeatureSet::discard(PyFeatureSet* self, PyObject* arg)
+{
+    if (Py_TYPE(arg) == &PyFeature::TYPE)
+    {
+        PyFeature* feature = (PyFeature*)arg;
+        Python::CriticalSection lock(self);
+        int index = self->findStore(feature->store);
+        if (index >= 0)
+        {
+            self->removeEntry(static_cast<uint32_t>(index), feature->feature.typedId());
+        }
+    }
+    Py_RETURN_NONE;
+}
+
+PyObject* PyFeatureSet::update(PyFeatureSet* self, PyObject* arg)
+{
+    Python::CriticalSection lock(self);
+    if (!self->addAll(arg)) return NULL;
+    Py_RETURN_NONE;
+}
+
+PyMethodDef PyFeatureSet::METHODS[] =
+{
+    { "add", (PyCFunction)add, METH_O, "Adds a feature to the set" },
+    { "clear", (PyCFunction)clear, METH_NOARGS, "Removes all features" },
+    { "discard", (PyCFunction)discard, METH_O,
+      "Removes a feature from the set, if it is present" },
+    { "update", (PyCFunction)update, METH_O,
+      "Adds a feature, or all features of a Features object or other iterable" },
+    { nullptr, nullptr, 0, nullptr }
+};
+
+PyNumberMethods PyFeatureSet::NUMBER_METHODS =
+{
+    .nb_subtract = (binaryfunc)difference,
+    .nb_bool = (inquiry)isTrue,
+    .nb_and = (binaryfunc)intersection,
+    .nb_xor = (binaryfunc)symmetricDifference,
+    .nb_or = (binaryfunc)union_,
+};
+
+PySequenceMethods PyFeatureSet::SEQUENCE_METHODS =
+{
+    .sq_length = (lenfunc)len,
+    .sq_contains = (objobjproc)contains,
+};
+
+PyTypeObject PyFeatureSet::TYPE =
+{
+    .tp_name = "geodesk.FeatureSet",
+    .tp_basicsize = sizeof(PyFeatureSet),
+    .tp_dealloc = (destructor)dealloc,
+    .tp_repr = (reprfunc)repr,
+    .tp_as_number = &NUMBER_METHODS,
+    .tp_as_sequence = &SEQUENCE_METHODS,
+    .tp_hash = PyObject_HashNotImplemented,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "A set of features, stored compactly by type and ID",
+    .tp_iter = (getiterfunc)iter,
+    .tp_methods = METHODS,
+    .tp_new = createNew,
+};
+
+
+PyObject* PyFeatureSetIterator::create(PyFeatureSet* set)
+{
+    PyFeatureSetIterator* self = (PyFeatureSetIterator*)TYPE.tp_alloc(&TYPE, 0);
+    if (self)
+    {
+        Py_INCREF(set);
+        self->set = set;
+        self->pos = 0;
+        self->version = set->version;
+    }
+    return self;
+}
+
+void PyFeatureSetIterator::dealloc(PyFeatureSetIterator* self)
+{
+    Py_DECREF(self->set);
+    Py_TYPE(self)->tp_free(self);
+}
+
+PyObject* PyFeatureSetIterator::next(PyFeatureSetIterator* self)
+{
+    PyFeatureSet* set = self->set;
+    // The position is guarded by the set's lock as well
+    Python::CriticalSection lock(set);
+    if (set->version != self->version)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "FeatureSet changed during iteration");
+        return NULL;
+    }
+    while (self->pos < set->capacity)
+    {
+        const PyFeatureSet::Entry& entry = set->entries[self->pos++];
+        if (!entry.feature.isNull())
+        {
+            return PyFeature::create(set->stores[entry.store], entry.feature, Py_None);
+        }
+    }
+    return NULL;
+}
+
+PyTypeObject PyFeatureSetIterator::TYPE =
+{
+    .tp_name = "geodesk.FeatureSetIterator",
+    .tp_basicsize = sizeof(PyFeatureSetIterator),
+    .tp_dealloc = (destructor)dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_DISALLOW_INSTANTIATION,
+    .tp_iter = PyObject_SelfIter,
+    .tp_iternext = (iternextfunc)next,
+};
@@ -0,0 +1,112 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#pragma once
+
+#include <Python.h>
+#include <vector>
+#include <geodesk/feature/FeaturePtr.h>
+#include <geodesk/feature/FeatureStore.h>
+#include <geodesk/filter/Filter.h>
+#include <geodesk/geom/Box.h>
+
+using namespace geodesk;
+
+/// \brief A set of features (geodesk.FeatureSet), stored as the typed
+/// IDs and pointers of the features rather than as Python objects.
+///
+/// Features are identified by their store and typed ID, so the copies
+/// of a feature that spans several tiles count as one. The set is an
+/// open-addressing hash table with linear probing (about 24 bytes per
+/// feature, compared to a set entry plus a Feature object); Feature
+/// objects are only created when the set is iterated.
+///
+/// The set holds a reference to the store of each of its features,
+/// which keeps their tile data mapped.
+///
+class PyFeatureSet : public PyObject
+{
+public:
+    struct Entry
+    {
+        uint64_t typedId;
+        FeaturePtr feature;     // null if the slot is empty
+        uint32_t store;         // index into stores
+    };
+
+    Entry* entries;
+    uint32_t capacity;          // always a power of 2 (or 0)
+    uint32_t count;
+    uint32_t version;           // changes whenever entries are added or removed
+    std::vector<FeatureStore*> stores;
+
+    static PyTypeObject TYPE;
+    static PyMethodDef METHODS[];
+    static PyNumberMethods NUMBER_METHODS;
+    static PySequenceMethods SEQUENCE_METHODS;
+
+    static PyFeatureSet* createEmpty();
+    static PyObject* createNew(PyTypeObject* type, PyObject* args, PyObject* kwargs);
+    static void dealloc(PyFeatureSet* self);
+    static PyObject* iter(PyFeatureSet* self);
+    static Py_ssize_t len(PyFeatureSet* self);
+    static int contains(PyFeatureSet* self, PyObject* item);
+    static PyObject* repr(PyFeatureSet* self);
+    static int isTrue(PyFeatureSet* self);
+
+    // Set algebra (both operands must be FeatureSets)
+
+    static PyObject* union_(PyObject* a, PyObject* b);
+    static PyObject* intersection(PyObject* a, PyObject* b);
+    static PyObject* difference(PyObject* a, PyObject* b);
+    static PyObject* symmetricDifference(PyObject* a, PyObject* b);
+
+    // Methods
+
+    static PyObject* add(PyFeatureSet* self, PyObject* arg);
+    static PyObject* clear(PyFeatureSet* self, PyObject* unused);
+    static PyObject* discard(PyFeatureSet* self, PyObject* arg);
+    static PyObject* update(PyFeatureSet* self, PyObject* arg);
+
+    /// Adds a feature; returns 1 if it was added, 0 if the set already
+    /// contains it, or -1 (with a Python exception set) on error
+    int insert(FeatureStore* store, FeaturePtr feature);
+    bool containsId(FeatureStore* store, uint64_t typedId) const;
+
+    /// Adds a Feature, or all features of a Features selection or other
+    /// iterable; returns false (with a Python exception set) on error
+    bool addAll(PyObject* obj);
+
+    /// Returns a Filter that only accepts the features of this set that
+    /// belong to `store` (a snapshot of the set's current contents), or
+    /// NULL if the set contains none of them. `bounds` are the bounds of
+    /// the selection to which the filter is applied.
+    const Filter* createFilter(FeatureStore* store, const Box& bounds) const;
+
+private:
+    const Entry* find(uint32_t storeIndex, uint64_t typedId) const;
+    int insertEntry(uint32_t storeIndex, uint64_t typedId, FeaturePtr feature);
+    bool removeEntry(uint32_t storeIndex, uint64_t typedId);
+    bool resize(uint32_t newCapacity);
+    uint32_t slotOf(uint32_t storeIndex, uint64_t typedId) const;
+    uint32_t storeIndex(FeatureStore* store);
+    int findStore(FeatureStore* store) const;
+    /// Adds all entries of `other` for which `pred(store, entry)` is true
+    template<typename Pred>
+    bool addEntries(const PyFeatureSet* other, Pred pred);
+};
+
+
+class PyFeatureSetIterator : public PyObject
+{
+public:
+    PyFeatureSet* set;
+    uint32_t pos;
+    uint32_t version;
+
+    static PyTypeObject TYPE;
+
+    static PyObject* create(PyFeatureSet* set);
+    static void dealloc(PyFeatureSetIterator* self);
+    static PyObject* next(PyFeatureSetIterator* self);
+};
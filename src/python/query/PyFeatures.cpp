@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 
 #include "PyFeatures.h"
+#include <numeric>
+#include <vector>
 #include <geodesk/filter/ComboFilter.h>
 #include <geodesk/filter/IntersectsFilter.h>
 // #include "match/MatcherDecoder.h"       // TODO: remove (only needed for explain)
@@ -10,13 +12,19 @@
 #include <geodesk/geom/Length.h>
 #include "python/Environment.h"
 #include "python/feature/PyFeature.h"
+#include "python/feature/PyTagAccessor.h"
+#include "python/filter/filters.h"
 #include "python/format/PyFormatter.h"
 #include "python/format/PyMap.h"
+#include "python/geom/GeometryCache.h"
 #include "python/geom/PyBox.h"
 #include "python/geom/PyCoordinate.h"
 #include "python/util/PyFastMethod.h"
+#include "PyAsyncQuery.h"
 #include "PyQuery.h"
 #include "PyTile.h"
+#include "QueryScan.h"
+#include "StoreState.h"
 #include <clarisma/util/Parser.h>
 
 #include "PyFeatures_attr.cxx"
@@ -46,6 +54,10 @@ PyFeatures* PyFeatures::createWith(PyFeatures* base, uint32_t flags,
         self->acceptedTypes = acceptedTypes;
         self->matcher = matcher;
         self->filter = filter;
+        Py_XINCREF(base->queries);
+        self->queries = base->queries;
+        self->threads = base->threads;
+        self->maxBufferedResults = base->maxBufferedResults;
         self->bounds = *bounds;      
         // If base does not use bounds, this copies relatedFeature from the union
         // as long as base->bounds is passed as bounds
@@ -117,6 +129,24 @@ PyFeatures* PyFeatures::createRelated(PyFeatures* base, SelectionType* selection
 
 
 
+PyFeatures* PyFeatures::createWorld(FeatureStore* store)
+{
+    PyFeatures* self = (PyFeatures*)TYPE.tp_alloc(&TYPE, 0);
+    if (self)
+    {
+        self->selectionType = &World::SUBTYPE;
+        store->addref();
+        self->store = store;
+        self->flags = SelectionFlags::USES_BOUNDS;
+        self->acceptedTypes = FeatureTypes::ALL;
+        self->matcher = store->getAllMatcher();
+        self->filter = NULL;
+        self->bounds = Box::ofWorld();
+    }
+    return self;
+}
+
+
 PyFeatures* PyFeatures::createNew(PyTypeObject* type, PyObject* args, PyObject* kwds)
 {
     Py_ssize_t argCount = PySequence_Length(args);
@@ -125,9 +155,69 @@ PyFeatures* PyFeatures::createNew(PyTypeObject* type, PyObject* args, PyObject*
         PyErr_SetString(PyExc_TypeError, "Missing argument <gol_file>");
         return NULL;
     }
-    if (argCount == 1 && !kwds)
+    if (argCount == 1)
     {
         PyObject* arg = PyTuple_GetItem(args, 0);
+        int threads = 0;
+        int64_t maxBuffered = 0;
+        int64_t geometryCacheSize = -1;
+        if (kwds)
+        {
+            // threads and max_buffered_results only apply to this object
+            // and the selections derived from it; geometry_cache sets
+            // the budget of the store's shared cache (only if specified
+            // explicitly)
+            PyObject* key;
+            PyObject* value;
+            Py_ssize_t pos = 0;
+            while (PyDict_Next(kwds, &pos, &key, &value))
+            {
+                if (PyUnicode_Check(key) &&
+                    PyUnicode_CompareWithASCIIString(key, "threads") == 0)
+                {
+                    if (value == Py_None)
+                    {
+                        threads = 0;
+                    }
+                    else if (Python::setInt(value, &threads, 1, 4096) < 0)
+                    {
+                        return NULL;
+                    }
+                    continue;
+                }
+                if (PyUnicode_Check(key) &&
+                    PyUnicode_CompareWithASCIIString(key, "max_buffered_results") == 0)
+                {
+                    // A count of results held by the bindings (the
+                    // engine's own queue isn't limited)
+                    if (value == Py_None)
+                    {
+                        maxBuffered = 0;
+                    }
+                    else if (Python::setLong(value, &maxBuffered, 1, 1 << 30) < 0)
+                    {
+                        return NULL;
+                    }
+                    continue;
+                }
+                if (PyUnicode_Check(key) &&
+                    PyUnicode_CompareWithASCIIString(key, "geometry_cache") == 0)
+                {
+                    // Budget in bytes (0 disables caching)
+                    if (value == Py_None)
+                    {
+                        geometryCacheSize = GeometryCache::DEFAULT_MAX_BYTES;
+                    }
+                    else if (Python::setLong(value, &geometryCacheSize, 0, INT64_MAX) < 0)
+                    {
+                        return NULL;
+                    }
+                    continue;
+                }
+                PyErr_Format(PyExc_TypeError, "Unexpected keyword argument: %S", key);
+                return NULL;
+            }
+        }
         std::string_view fileName = Python::getStringView(arg);
         if (!fileName.data()) return NULL;
         FeatureStore* store;
@@ -150,17 +240,15 @@ PyFeatures* PyFeatures::createNew(PyTypeObject* type, PyObject* args, PyObject*
             PyErr_SetString(PyExc_RuntimeError, ex.what());
             return NULL;
         }
-        PyFeatures* self = (PyFeatures*)TYPE.tp_alloc(&TYPE, 0);
+        if (geometryCacheSize >= 0)
+        {
+            StoreState::of(store)->geometries().setMaxBytes(geometryCacheSize);
+        }
+        PyFeatures* self = createWorld(store);
         if (self)
         {
-            self->selectionType = &World::SUBTYPE;
-            store->addref();
-            self->store = store;
-            self->flags = SelectionFlags::USES_BOUNDS;
-            self->acceptedTypes = FeatureTypes::ALL;
-            self->matcher = store->getAllMatcher();
-            self->filter = NULL;
-            self->bounds = Box::ofWorld();
+            self->threads = threads;
+            self->maxBufferedResults = static_cast<uint32_t>(maxBuffered);
         }
         return self;
     }
@@ -175,7 +263,8 @@ void PyFeatures::dealloc(PyFeatures* self)
 {
     self->matcher->release();
     if(self->filter) (self->filter->release());
-    if(self->store) self->store->release();
+    Py_XDECREF(self->queries);
+    if(self->store) StoreState::release(self->store);
     Py_TYPE(self)->tp_free(self);
 }
 
@@ -268,9 +357,14 @@ PyObject* PyFeatures::call(PyFeatures* self, PyObject* args, PyObject* kwargs)
         {
             PyFeature* feature = (PyFeature*)arg;
             IntersectsFilterFactory filterFactory;
-            // TODO: check if factory throws or returns null?
-            return self->withFilter(filterFactory.forFeature(
-                feature->store, feature->feature));
+            const Filter* filter = filters::forFeature(filterFactory,
+                feature->store, feature->feature);
+            if (!filter)
+            {
+                if (PyErr_Occurred()) return NULL;
+                return self->getEmpty();
+            }
+            return self->withFilter(filter);
         }
         if (type->tp_name[0] != 'g')    
         {
@@ -318,8 +412,12 @@ uint64_t PyFeatures::getCount()
 PyObject* PyFeatures::World::countFeatures(PyFeatures* self) 
 {
     int64_t count = 0;
-    Query query(self->store, self->bounds, self->acceptedTypes, self->matcher, self->filter);
-    while (!query.next().isNull()) count++;
+    Py_BEGIN_ALLOW_THREADS
+    {
+        Query query(self->store, self->bounds, self->acceptedTypes, self->matcher, self->filter);
+        while (!query.next().isNull()) count++;
+    }
+    Py_END_ALLOW_THREADS
     // TODO: error handling
     return PyLong_FromLongLong(count);
 }
@@ -558,10 +656,35 @@ PyTypeObject PyFeatures::TYPE =
     .tp_doc = "Features objects", 
     .tp_iter = (getiterfunc)PyFeatures::iter,  
     .tp_iternext = (iternextfunc)next,
+    .tp_methods = METHODS,
     // .tp_init = (initproc)PyFeatures::init,   
     .tp_new = (newfunc)createNew
 };
 
+/**
+ * Sets the query strings of `self` to `base` (may be NULL) plus `query`.
+ */
+static int appendQueries(PyFeatures* self, PyObject* base, const char* query)
+{
+    PyObject* queryString = PyUnicode_FromString(query);
+    if (!queryString) return -1;
+    Py_ssize_t count = base ? PyTuple_GET_SIZE(base) : 0;
+    PyObject* queries = PyTuple_New(count + 1);
+    if (!queries)
+    {
+        Py_DECREF(queryString);
+        return -1;
+    }
+    for (Py_ssize_t i = 0; i < count; i++)
+    {
+        PyTuple_SET_ITEM(queries, i, Python::newRef(PyTuple_GET_ITEM(base, i)));
+    }
+    PyTuple_SET_ITEM(queries, count, queryString);
+    Py_XDECREF(self->queries);
+    self->queries = queries;
+    return 0;
+}
+
 PyFeatures* PyFeatures::withQuery(const char* query)
 {
     try
@@ -582,7 +705,13 @@ PyFeatures* PyFeatures::withQuery(const char* query)
 
         // TODO: combine newMatcher with any existing matcher
         if(filter) filter->addref();     // need to addref filter because createWith steals the ref
-        return createWith(this, flags | USES_MATCHER, newTypes, &bounds, newMatcher, filter);
+        PyFeatures* self = createWith(this, flags | USES_MATCHER, newTypes, &bounds, newMatcher, filter);
+        if (self && appendQueries(self, queries, query) < 0)
+        {
+            Py_DECREF(self);
+            return NULL;
+        }
+        return self;
     }
     catch (const ParseException& ex)
     {
@@ -610,14 +739,23 @@ PyFeatures* PyFeatures::withFilter(const Filter* newFilter)
         return getEmpty();
     }
 
-    // TODO: apply bounds!!!
-    // 
-    // TODO: fix
-    Box b = newFilter->getBounds();
-    // Box b = Box::simpleIntersection(bounds, newFilter->getBounds());
+    uint32_t newFlags = flags | USES_FILTER;
+    Box b;
+    if (flags & USES_BOUNDS)
+    {
+        // Narrow the bounds to those of the filter (e.g. the bounding box
+        // of a FeatureSet), so only the tiles that matter are searched
+        b = Box::simpleIntersection(bounds, newFilter->getBounds());
+        if (b.isEmpty())
+        {
+            newFilter->release();
+            return getEmpty();
+        }
+        if (!(b == Box::ofWorld())) newFlags |= BOUNDS_ACTIVE;
+    }
 
     matcher->addref();      // createWith consumes ref to matcher
-    return createWith(this, flags | USES_FILTER, newTypes, 
+    return createWith(this, newFlags, newTypes,
         (flags & USES_BOUNDS) ? &b : &bounds, 
             matcher, newFilter);
 }
@@ -679,8 +817,20 @@ PyFeatures* PyFeatures::withOther(PyFeatures* other)
         newFilter = nullptr;
     }
 
-    return createWith(this, flags | other->flags, newTypes,
+    PyFeatures* self = createWith(this, flags | other->flags, newTypes,
         &bounds, newMatcher, newFilter);
+    if (self && other->queries)
+    {
+        Py_XDECREF(self->queries);
+        self->queries = queries ? PySequence_Concat(queries, other->queries) :
+            Python::newRef(other->queries);
+        if (!self->queries)
+        {
+            Py_DECREF(self);
+            return NULL;
+        }
+    }
+    return self;
 }
 
 
@@ -822,6 +972,29 @@ bool PyFeatures::acceptsAny(FeatureTypes types)
 
 PyObject* PyFeatures::area(PyFeatures* self)
 {
+    if (self->selectionType == &World::SUBTYPE)
+    {
+        QueryScan scan(self);
+        std::vector<double> partials(scan.slotCount());
+        FeatureStore* store = self->store;
+        if (!scan.run([&partials, store](int slot, const FeaturePtr* features, size_t count)
+            {
+                double area = 0;
+                for (size_t i = 0; i < count; i++)
+                {
+                    FeaturePtr f = features[i];
+                    if (!f.isArea()) continue;
+                    area += f.isWay() ? Area::ofWay(WayPtr(f)) :
+                        Area::ofRelation(store, RelationPtr(f));
+                }
+                partials[slot] += area;
+            }))
+        {
+            return NULL;
+        }
+        return PyFloat_FromDouble(std::accumulate(partials.begin(), partials.end(), 0.0));
+    }
+
     double totalArea = 0;
     int res = self->forEach([&totalArea](PyObject* item)
     {
@@ -872,6 +1045,34 @@ PyObject* PyFeatures::length(PyFeatures* self)
     // Make it total_length?
     // Would need to change area to total_area
 
+    if (self->selectionType == &World::SUBTYPE)
+    {
+        QueryScan scan(self);
+        std::vector<double> partials(scan.slotCount());
+        FeatureStore* store = self->store;
+        if (!scan.run([&partials, store](int slot, const FeaturePtr* features, size_t count)
+            {
+                double length = 0;
+                for (size_t i = 0; i < count; i++)
+                {
+                    FeaturePtr f = features[i];
+                    if (f.isWay())
+                    {
+                        length += Length::ofWay(WayPtr(f));
+                    }
+                    else if (f.isRelation())
+                    {
+                        length += Length::ofRelation(store, RelationPtr(f));
+                    }
+                }
+                partials[slot] += length;
+            }))
+        {
+            return NULL;
+        }
+        return PyFloat_FromDouble(std::accumulate(partials.begin(), partials.end(), 0.0));
+    }
+
     double totalLength = 0;
     int res = self->forEach([&totalLength](PyObject* item)
     {
@@ -927,6 +1128,16 @@ PyObject* PyFeatures::refcount(PyFeatures* self)
     Py_RETURN_NONE;
 }
 
+PyObject* PyFeatures::geometry_cache_stats(PyFeatures* self)
+{
+    return StoreState::of(self->store)->geometries().stats();
+}
+
+PyObject* PyFeatures::queue_stats(PyFeatures* self)
+{
+    return StoreState::of(self->store)->stats(self->bufferedResultLimit());
+}
+
 PyObject* PyFeatures::relations(PyFeatures* self)
 {
     return (PyObject*)self->withTypes(FeatureTypes::RELATIONS);
@@ -976,26 +1187,12 @@ PyObject* PyFeatures::shape(PyFeatures* self)
 
 PyObject* PyFeatures::strings(PyFeatures* self)
 {
-    StringTable& strings = self->store->strings();
-    uint32_t count = strings.stringCount();
-    PyObject* list = PyList_New(count);
-    if (!list) return NULL;
-    for (uint32_t i = 0; i < count; ++i) 
-    {
-        PyObject* str = strings.getStringObject(i);
-        if(!str)
-        {
-            Py_DECREF(list);
-            return NULL;
-        }
-        PyList_SetItem(list, i, str);
-    }
-    return list;
+    return PyStringTable::create(self->store);
 }
 
 PyObject* PyFeatures::indexed_keys(PyFeatures* self)
 {
-    StringTable& strings = self->store->strings();
+    StringObjectCache* strings = StringObjectCache::of(self->store);
     const FeatureStore::IndexedKeyMap& keysToCategories = 
         self->store->keysToCategories();
     PyObject* list = PyList_New(keysToCategories.size());
@@ -1003,7 +1200,7 @@ PyObject* PyFeatures::indexed_keys(PyFeatures* self)
     int i = 0;
     for (auto it = keysToCategories.begin(); it != keysToCategories.end(); ++it)
     {
-        PyObject* str = strings.getStringObject(it->first);
+        PyObject* str = strings->get(it->first);
         if (!str)
         {
             Py_DECREF(list);
@@ -1038,6 +1235,37 @@ PyObject* PyFeatures::ways(PyFeatures* self)
 }
 
 
+// Asynchronous iteration
+
+PyObject* PyFeatures::acount(PyFeatures* self, PyObject* args, PyObject* kwargs)
+{
+    return PyAsyncQuery::count(self);
+}
+
+PyObject* PyFeatures::afirst(PyFeatures* self, PyObject* args, PyObject* kwargs)
+{
+    return PyAsyncQuery::first(self);
+}
+
+PyObject* PyFeatures::aiter(PyFeatures* self, PyObject* args, PyObject* kwargs)
+{
+    return PyAsyncQuery::create(self);
+}
+
+PyObject* PyFeatures::accessor(PyFeatures* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* KEYWORDS[] = { "key", "type", nullptr };
+    PyObject* key;
+    PyObject* type = (PyObject*)&PyUnicode_Type;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "U|$O:accessor", (char**)KEYWORDS,
+        &key, &type))
+    {
+        return NULL;
+    }
+    return PyTagAccessor::create(self->store, key, type);
+}
+
+
 PyObject* PyFeatures::auto_load(PyFeatures* self, PyObject* args, PyObject* kwargs)
 {
     PyErr_SetString(PyExc_NotImplementedError,
@@ -1171,8 +1399,13 @@ PyObject* PyFeatures::findById(FeatureType type, PyObject* args, PyObject* kwarg
     if (selectionType == &World::SUBTYPE)
     {
         FeatureIdFilter idFilter(typedId, filter);
-        Query query(store, bounds, types, matcher, &idFilter);
-        FeaturePtr feature = query.next();
+        FeaturePtr feature;
+        Py_BEGIN_ALLOW_THREADS
+        {
+            Query query(store, bounds, types, matcher, &idFilter);
+            feature = query.next();
+        }
+        Py_END_ALLOW_THREADS
         if (feature.isNull())
         {
             Py_RETURN_NONE;
@@ -13,7 +13,10 @@
 #include <geodesk/feature/TypedFeatureId.h>
 #include <geodesk/filter/FeatureNodeFilter.h>
 #include <geodesk/filter/WayNodeFilter.h>
+#include <geodesk/feature/Tip.h>
 #include <geodesk/geom/Box.h>
+#include <geodesk/geom/Tile.h>
+#include "python/feature/StringObjectCache.h"
 
 using namespace geodesk;
 namespace geodesk {
@@ -72,6 +75,13 @@ public:
     uint32_t flags;
     const MatcherHolder* matcher;
     const Filter* filter;
+    PyObject* queries;              // tuple of the query strings applied to
+                                    // this selection (or NULL), kept so the
+                                    // selection can be pickled
+    int threads;                    // Features(..., threads=N), or 0 if only
+                                    // limited by the size of the WorkPool
+    uint32_t maxBufferedResults;    // Features(..., max_buffered_results=N),
+                                    // or 0 for the default
     union
     {
         Box bounds;                 // If used, USES_BOUNDS flag must be set 
@@ -80,7 +90,17 @@ public:
         FeaturePtr relatedFeature;  // If used, USES_BOUNDS flag must be clear
     };
 
+    static const uint32_t DEFAULT_MAX_BUFFERED_RESULTS = 8192;
+
+    /// The number of results that a query of this selection may
+    /// buffer ahead of its consumer
+    size_t bufferedResultLimit() const
+    {
+        return maxBufferedResults ? maxBufferedResults : DEFAULT_MAX_BUFFERED_RESULTS;
+    }
+
     static PyTypeObject TYPE;
+    static PyMethodDef METHODS[];
     static PyMappingMethods MAPPING_METHODS;
     static PyNumberMethods NUMBER_METHODS;
     static PySequenceMethods SEQUENCE_METHODS;
@@ -98,6 +118,10 @@ public:
     static PyFeatures* createRelated(PyFeatures* base, SelectionType* selectionType, 
         FeaturePtr relatedFeature, FeatureTypes acceptedTypes);
     static PyFeatures* createEmpty(FeatureStore* store, const MatcherHolder* matcher);
+    /**
+     * Creates an unconstrained WORLD Selection for an open store.
+     */
+    static PyFeatures* createWorld(FeatureStore* store);
 
     /**
      * Creates a new PyFeatures instance based on an existing one.
@@ -136,10 +160,45 @@ public:
     static PyObject* iter(PyFeatures* self);
     static PyObject* next(PyFeatures* self);
 
+    /**
+     * Pickles a selection as the path of its GOL, its query strings,
+     * its bounding box and its feature types. Selections with spatial
+     * or custom filters (PicklingError), and selections of related
+     * features (members, nodes, parents) cannot be pickled.
+     */
+    static PyObject* reduce(PyFeatures* self, PyObject* unused);
+    /**
+     * Recreates a pickled selection (module function _restore_features)
+     */
+    static PyObject* restore(PyObject* module, PyObject* args);
+    /**
+     * Returns the World selection of the GOL at the given path, opening
+     * the store only if this process hasn't already done so.
+     */
+    static PyFeatures* openCached(PyObject* path);
+    /**
+     * Closes the stores opened by openCached() (unless they are still
+     * used elsewhere); called when the last module instance is freed.
+     */
+    static void clearStoreCache();
+
     PyFeatures* withQuery(const char* query);
     PyFeatures* withFilter(const Filter* filter);
     PyFeatures* withTypes(FeatureTypes newTypes);
     PyFeatures* withOther(PyFeatures* other);
+    /**
+     * Restricts this selection to the features that are stored in the
+     * given tile. Features that span several tiles are only returned
+     * by the westernmost/northernmost of their tiles that lies within
+     * the bounds of this selection, so each feature of the selection
+     * belongs to exactly one of the tiles returned by `tiles`.
+     */
+    PyFeatures* withTile(Tile tile, Tip tip);
+    /**
+     * Restricts a selection to a tile (module function _tile_features,
+     * used by the workers of parallel_map)
+     */
+    static PyObject* tileFeatures(PyObject* module, PyObject* args);
 
     // Selection Methods
 
@@ -163,6 +222,7 @@ public:
     static PyObject* area(PyFeatures* self);
     static PyObject* count(PyFeatures* self);
     static PyObject* first(PyFeatures* self);
+    static PyObject* geometry_cache_stats(PyFeatures* self);
     static PyObject* guid(PyFeatures* self);
     static PyObject* indexed_keys(PyFeatures* self);
     static PyObject* length(PyFeatures* self);
@@ -171,6 +231,7 @@ public:
     static PyObject* nodes(PyFeatures* self);
     static PyObject* one(PyFeatures* self);
     static PyObject* properties(PyFeatures* self);
+    static PyObject* queue_stats(PyFeatures* self);
     static PyObject* refcount(PyFeatures* self);
     static PyObject* relations(PyFeatures* self);
     static PyObject* revision(PyFeatures* self);
@@ -182,9 +243,22 @@ public:
     
     // Methods
 
+    static PyObject* accessor(PyFeatures* self, PyObject* args, PyObject* kwargs);
+    static PyObject* acount(PyFeatures* self, PyObject* args, PyObject* kwargs);
+    static PyObject* afirst(PyFeatures* self, PyObject* args, PyObject* kwargs);
+    static PyObject* aiter(PyFeatures* self, PyObject* args, PyObject* kwargs);
     static PyObject* auto_load(PyFeatures* self, PyObject* args, PyObject* kwargs);
+    static PyObject* distances(PyFeatures* self, PyObject* args, PyObject* kwargs);
+    static PyObject* distinct(PyFeatures* self, PyObject* args, PyObject* kwargs);
     static PyObject* explain(PyFeatures* self, PyObject* args, PyObject* kwargs);
+    static PyObject* grid(PyFeatures* self, PyObject* args, PyObject* kwargs);
+    static PyObject* key_stats(PyFeatures* self, PyObject* args, PyObject* kwargs);
     static PyObject* load(PyFeatures* self, PyObject* args, PyObject* kwargs);
+    static PyObject* num_array(PyFeatures* self, PyObject* args, PyObject* kwargs);
+    static PyObject* parallel_map(PyFeatures* self, PyObject* args, PyObject* kwargs);
+    static PyObject* sample(PyFeatures* self, PyObject* args, PyObject* kwargs);
+    static PyObject* tile_stats(PyFeatures* self, PyObject* args, PyObject* kwargs);
+    static PyObject* top(PyFeatures* self, PyObject* args, PyObject* kwargs);
     static PyObject* update(PyFeatures* self, PyObject* args, PyObject* kwargs);
 
     // Lookup by ID
@@ -290,6 +364,9 @@ class PyMemberIterator : public PyObject
 public:
     PyObject* target;
     MemberIterator iter;
+    StringObjectCache* strings;
+    int roleCode;               // global-string code of `role`, or -1
+    PyObject* role;             // the role of the current member
 
     static PyTypeObject TYPE;
 
@@ -0,0 +1,73 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "PyFeatures.h"
+#include <geodesk/geom/SpatialUnit.h>
+#include "python/Environment.h"
+#include "python/geom/DistanceMeasurer.h"
+#include "python/geom/PyMercator.h"
+#include "python/geom/ShapeHolder.h"
+#include "python/util/PyNumArray.h"
+#include "FeatureColumns.h"
+#include "QueryScan.h"
+
+PyObject* PyFeatures::distances(PyFeatures* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* KEYWORDS[] = { "geom", "units", nullptr };
+    PyObject* geomObj;
+    const char* unitsArg = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|s:distances", (char**)KEYWORDS,
+        &geomObj, &unitsArg))
+    {
+        return NULL;
+    }
+    int units = PyMercator::unitsFromArg(unitsArg, false);
+    if (units < 0) return NULL;
+    bool world = self->selectionType == &World::SUBTYPE;
+    if (!world && self->selectionType != &Empty::SUBTYPE)
+    {
+        PyErr_SetString(PyExc_TypeError,
+            "distances() is not supported for selections of related "
+            "features (members, nodes or parents)");
+        return NULL;
+    }
+
+    // The target is turned into a GEOS geometry (or, for a Shapely
+    // geometry, borrowed) even if the kernel can measure it, since
+    // relations are always measured via GEOS
+    GEOSContextHandle_t ctx = Environment::get().getGeosContext();
+    if (!ctx) return NULL;
+    ShapeHolder target;
+    if (!target.setFromObject(geomObj, ctx)) return NULL;
+    GEOSGeometry* targetGeom = target.asGeometry();
+    if (!targetGeom) return NULL;
+
+    if (!world)
+    {
+        FeatureColumns<double> empty(0);
+        return empty.toDict(PyNumArray::create('d', 0));
+    }
+
+    QueryScan scan(self);
+    FeatureColumns<double> columns(scan.slotCount());
+    DistanceMeasurer measurer(self->store, geomObj, targetGeom, scan.slotCount());
+    if (!scan.run([&](int slot, const FeaturePtr* features, size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                columns.add(slot, features[i], measurer.meters(slot, features[i]));
+            }
+        }))
+    {
+        return NULL;
+    }
+    const auto& rows = columns.rows();
+    PyNumArray* values = PyNumArray::create('d', rows.size());
+    if (!values) return NULL;
+    double* p = values->values<double>();
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        p[i] = SpatialUnit::fromMeters(rows[i].value, units);
+    }
+    return columns.toDict(values);
+}
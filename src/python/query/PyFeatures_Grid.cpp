@@ -0,0 +1,268 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "PyFeatures.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+#include <geodesk/geom/Area.h>
+#include <geodesk/geom/Length.h>
+#include <geodesk/geom/Mercator.h>
+#include "python/geom/PyBox.h"
+#include "python/util/PyNumArray.h"
+#include "python/util/util.h"
+#include "QueryScan.h"
+
+enum class GridValue
+{
+    COUNT,
+    LENGTH,
+    AREA
+};
+
+// Upper limit for the number of cells, so a typo in the cell size
+// doesn't exhaust memory
+static const int64_t MAX_GRID_CELLS = 1 << 26;
+
+// Each worker thread bins into its own partial grid, which is dense
+// unless the dense grids of all workers would have more cells than this;
+// in that case, the workers use sparse grids instead, which only take
+// up memory for the cells in which they have binned features
+static const size_t MAX_DENSE_CELLS = 1 << 24;
+
+template<typename T>
+class PartialGrids
+{
+public:
+    PartialGrids(int slots, size_t cellCount) :
+        cellCount_(cellCount),
+        dense_(cellCount * slots <= MAX_DENSE_CELLS),
+        denseGrids_(dense_ ? slots : 0),
+        sparseGrids_(dense_ ? 0 : slots)
+    {
+    }
+
+    void add(int slot, size_t cell, T value)
+    {
+        if (dense_)
+        {
+            std::vector<T>& grid = denseGrids_[slot];
+            if (grid.empty()) grid.resize(cellCount_);
+            grid[cell] += value;
+        }
+        else
+        {
+            sparseGrids_[slot][cell] += value;
+        }
+    }
+
+    /// Adds up the partial grids
+    void addTo(T* cells) const
+    {
+        for (const std::vector<T>& grid : denseGrids_)
+        {
+            if (grid.empty()) continue;
+            for (size_t i = 0; i < cellCount_; i++) cells[i] += grid[i];
+        }
+        for (const std::unordered_map<size_t,T>& grid : sparseGrids_)
+        {
+            for (const auto& [cell, v] : grid) cells[cell] += v;
+        }
+    }
+
+private:
+    size_t cellCount_;
+    bool dense_;
+    std::vector<std::vector<T>> denseGrids_;
+    std::vector<std::unordered_map<size_t,T>> sparseGrids_;
+};
+
+/// A feature is binned by its location (for nodes) or the center
+/// of its bounding box (for ways and relations)
+static Coordinate gridLocation(FeaturePtr feature)
+{
+    if (feature.isNode()) return NodePtr(feature).xy();
+    return Coordinate(
+        static_cast<int32_t>((static_cast<int64_t>(feature.minX()) + feature.maxX()) / 2),
+        static_cast<int32_t>((static_cast<int64_t>(feature.minY()) + feature.maxY()) / 2));
+}
+
+PyObject* PyFeatures::grid(PyFeatures* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* KEYWORDS[] = { "cell_size_meters", "box", "value", nullptr };
+    double cellMeters;
+    PyObject* boxArg = Py_None;
+    const char* valueName = "count";
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "d|$Os:grid", (char**)KEYWORDS,
+        &cellMeters, &boxArg, &valueName))
+    {
+        return NULL;
+    }
+    GridValue value;
+    if (strcmp(valueName, "count") == 0)
+    {
+        value = GridValue::COUNT;
+    }
+    else if (strcmp(valueName, "length") == 0)
+    {
+        value = GridValue::LENGTH;
+    }
+    else if (strcmp(valueName, "area") == 0)
+    {
+        value = GridValue::AREA;
+    }
+    else
+    {
+        PyErr_Format(PyExc_ValueError,
+            "Invalid value: '%s' (must be 'count', 'length' or 'area')", valueName);
+        return NULL;
+    }
+    if (!(cellMeters > 0) || std::isinf(cellMeters))
+    {
+        PyErr_SetString(PyExc_ValueError, "cell_size_meters must be positive");
+        return NULL;
+    }
+
+    bool world = self->selectionType == &World::SUBTYPE;
+    if (!world && self->selectionType != &Empty::SUBTYPE)
+    {
+        PyErr_SetString(PyExc_TypeError,
+            "grid() is not supported for selections of related "
+            "features (members, nodes or parents)");
+        return NULL;
+    }
+
+    Box box;
+    if (boxArg != Py_None)
+    {
+        if (Py_TYPE(boxArg) != &PyBox::TYPE)
+        {
+            PyErr_SetString(PyExc_TypeError, "box must be a Box");
+            return NULL;
+        }
+        box = ((PyBox*)boxArg)->box;
+    }
+    else if (world && (self->flags & SelectionFlags::BOUNDS_ACTIVE))
+    {
+        box = self->bounds;
+    }
+    else
+    {
+        PyErr_SetString(PyExc_ValueError,
+            "box is required for a selection without a bounding box");
+        return NULL;
+    }
+    if (box.isEmpty())
+    {
+        PyErr_SetString(PyExc_ValueError, "box must not be empty");
+        return NULL;
+    }
+
+    // Cells are squares in Mercator units, sized to match the
+    // requested size at the center of the box
+    double cellUnits = Mercator::unitsFromMeters(cellMeters, box.center().y);
+    int64_t cellSize = std::max(static_cast<int64_t>(std::round(cellUnits)), int64_t(1));
+    // (The edges of the box are inclusive)
+    int64_t columns = (box.width() + cellSize) / cellSize;
+    int64_t rows = (box.height() + cellSize) / cellSize;
+    if (rows * columns > MAX_GRID_CELLS)
+    {
+        PyErr_Format(PyExc_ValueError,
+            "Grid of %lld x %lld cells is too large (increase cell_size_meters)",
+            (long long)rows, (long long)columns);
+        return NULL;
+    }
+
+    PyNumArray* result = PyNumArray::create(
+        value == GridValue::COUNT ? 'I' : 'd', rows, columns);
+    if (!result || !world) return result;
+
+    // Only the area of the box needs to be queried (features
+    // binned outside of the grid are skipped anyway)
+    PyFeatures* features = self;
+    if (boxArg != Py_None)
+    {
+        PyObject* boxArgs = PyTuple_Pack(1, boxArg);
+        PyObject* boxed = boxArgs ? PyFeatures::call(self, boxArgs, nullptr) : NULL;
+        Py_XDECREF(boxArgs);
+        if (!boxed)
+        {
+            Py_DECREF(result);
+            return NULL;
+        }
+        features = (PyFeatures*)boxed;
+    }
+    else
+    {
+        Py_INCREF(features);
+    }
+
+    // Rows are ordered north to south (like the rows of a raster image).
+    // Each thread bins into its own partial grid; the grids are added up
+    // once the query is done
+    int32_t minX = box.minX();
+    int32_t maxY = box.maxY();
+    size_t cellCount = static_cast<size_t>(rows * columns);
+    FeatureStore* store = self->store;
+    bool ok = true;
+    if (features->selectionType == &World::SUBTYPE)
+    {
+        QueryScan scan(features);
+        if (value == GridValue::COUNT)
+        {
+            PartialGrids<uint32_t> grids(scan.slotCount(), cellCount);
+            ok = scan.run([&](int slot, const FeaturePtr* batch, size_t count)
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    Coordinate c = gridLocation(batch[i]);
+                    int64_t col = (static_cast<int64_t>(c.x) - minX) / cellSize;
+                    int64_t row = (static_cast<int64_t>(maxY) - c.y) / cellSize;
+                    if (col < 0 || col >= columns || row < 0 || row >= rows) continue;
+                    grids.add(slot, static_cast<size_t>(row * columns + col), 1);
+                }
+            });
+            grids.addTo(result->values<uint32_t>());
+        }
+        else
+        {
+            bool area = value == GridValue::AREA;
+            PartialGrids<double> grids(scan.slotCount(), cellCount);
+            ok = scan.run([&](int slot, const FeaturePtr* batch, size_t count)
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    FeaturePtr f = batch[i];
+                    if (f.isNode()) continue;
+                    if (area && !f.isArea()) continue;
+                    Coordinate c = gridLocation(f);
+                    int64_t col = (static_cast<int64_t>(c.x) - minX) / cellSize;
+                    int64_t row = (static_cast<int64_t>(maxY) - c.y) / cellSize;
+                    if (col < 0 || col >= columns || row < 0 || row >= rows) continue;
+                    double v;
+                    if (area)
+                    {
+                        v = f.isWay() ? Area::ofWay(WayPtr(f)) :
+                            Area::ofRelation(store, RelationPtr(f));
+                    }
+                    else
+                    {
+                        v = f.isWay() ? Length::ofWay(WayPtr(f)) :
+                            Length::ofRelation(store, RelationPtr(f));
+                    }
+                    grids.add(slot, static_cast<size_t>(row * columns + col), v);
+                }
+            });
+            grids.addTo(result->values<double>());
+        }
+    }
+    Py_DECREF(features);
+    if (!ok)
+    {
+        Py_DECREF(result);
+        return NULL;
+    }
+    return result;
+}
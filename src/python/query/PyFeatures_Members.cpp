@@ -92,6 +92,8 @@ PyObject* PyMemberIterator::create(PyFeatures* features)
         // the PyMemberIterator is alive
         new(&self->iter)MemberIterator(features->store, pBody,
             features->acceptedTypes, features->matcher, features->filter);
+        self->strings = StringObjectCache::of(features->store);
+        self->roleCode = -1;
     }
     return (PyObject*)self;
 }
@@ -109,6 +111,8 @@ PyObject* PyMemberIterator::create(PyFeature* rel)
         // the PyMemberIterator is alive
         new(&self->iter)MemberIterator(store, pBody, FeatureTypes::ALL,
             store->borrowAllMatcher(), NULL);
+        self->strings = StringObjectCache::of(store);
+        self->roleCode = -1;
     }
     return (PyObject*)self;
 }
@@ -116,6 +120,7 @@ PyObject* PyMemberIterator::create(PyFeature* rel)
 void PyMemberIterator::dealloc(PyMemberIterator* self)
 {
     Py_DECREF(self->target);
+    Py_XDECREF(self->role);
     self->iter.~MemberIterator();
     Py_TYPE(self)->tp_free(self);
 }
@@ -124,7 +129,23 @@ PyObject* PyMemberIterator::next(PyMemberIterator* self)
 {
     FeaturePtr feature = self->iter.next();
     if (feature.isNull()) return NULL;
-    return PyFeature::create(self->iter.store(), feature, self->iter.borrowCurrentRole());
+    int roleCode = self->iter.currentRoleCode();
+    if (roleCode < 0)
+    {
+        // A local role (the iterator has its own object for it)
+        Python::set(&self->role, self->iter.borrowCurrentRole());
+    }
+    else if (roleCode != self->roleCode)
+    {
+        // Members with the same role tend to be grouped together, so
+        // we only need to fetch the shared role string once per run
+        PyObject* role = self->strings->get(roleCode);
+        if (!role) return NULL;
+        Python::set(&self->role, role);
+        Py_DECREF(role);
+    }
+    self->roleCode = roleCode;
+    return PyFeature::create(self->iter.store(), feature, self->role);
 }
 
 PyTypeObject PyMemberIterator::TYPE =
@@ -0,0 +1,64 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "PyFeatures.h"
+#include <cmath>
+#include "python/feature/TagReader.h"
+#include "python/util/PyNumArray.h"
+#include "python/util/util.h"
+#include "FeatureColumns.h"
+#include "QueryScan.h"
+
+PyObject* PyFeatures::num_array(PyFeatures* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* KEYWORDS[] = { "key", "default", nullptr };
+    PyObject* keyObj;
+    double defaultValue = NAN;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "U|$d:num_array", (char**)KEYWORDS,
+        &keyObj, &defaultValue))
+    {
+        return NULL;
+    }
+    bool world = self->selectionType == &World::SUBTYPE;
+    if (!world && self->selectionType != &Empty::SUBTYPE)
+    {
+        PyErr_SetString(PyExc_TypeError,
+            "num_array() is not supported for selections of related "
+            "features (members, nodes or parents)");
+        return NULL;
+    }
+    TagReader reader;
+    if (!reader.init(self->store, keyObj)) return NULL;
+    if (!world)
+    {
+        FeatureColumns<double> empty(0);
+        return empty.toDict(PyNumArray::create('d', 0));
+    }
+
+    // Values are parsed by the query workers (using the same rules
+    // as Feature.num(), e.g. "50 mph" yields 50); features that lack
+    // the tag, or whose value isn't a number, get the default
+    QueryScan scan(self);
+    FeatureColumns<double> columns(scan.slotCount());
+    if (!scan.run([&](int slot, const FeaturePtr* features, size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                double value;
+                if (!reader.toNumber(reader.get(features[i].tags()), value))
+                {
+                    value = defaultValue;
+                }
+                columns.add(slot, features[i], value);
+            }
+        }))
+    {
+        return NULL;
+    }
+    const auto& rows = columns.rows();
+    PyNumArray* values = PyNumArray::create('d', rows.size());
+    if (!values) return NULL;
+    double* p = values->values<double>();
+    for (size_t i = 0; i < rows.size(); i++) p[i] = rows[i].value;
+    return columns.toDict(values);
+}
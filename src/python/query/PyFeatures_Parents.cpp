@@ -261,11 +261,12 @@ PyObject* PyNodeParentIterator::next(PyNodeParentIterator* self)
     // We need to distinguish between "no more features" and 
     // "PyFeature allocation failed", hence we call the underlying
     // query directly
-    FeaturePtr pFeature = self->wayQuery->query.next();
+    FeaturePtr pFeature = self->wayQuery->nextFeature();
     if (!pFeature.isNull())
     {
         return PyFeature::create(self->target->store, pFeature, Py_None);
     }
+    if (PyErr_Occurred()) return NULL;
     // Exhausted all relations and ways, iteration is done
     self->status = IterationStatus::DONE;
     return NULL;
@@ -0,0 +1,151 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "PyFeatures.h"
+#include "python/Environment.h"
+#include "python/util/util.h"
+#include "StoreState.h"
+
+// Selections are pickled by value (path, queries, bounds, types), and
+// re-created by the receiving process via _restore_features(). Each
+// process keeps its stores open once opened (the OS shares the pages
+// of the memory-mapped GOL among all processes), so unpickling many
+// features or selections doesn't reopen the store each time.
+
+static PyObject* STORE_CACHE = nullptr;     // path -> World selection
+
+PyFeatures* PyFeatures::openCached(PyObject* path)
+{
+    if (!STORE_CACHE)
+    {
+        STORE_CACHE = PyDict_New();
+        if (!STORE_CACHE) return NULL;
+    }
+    PyObject* world = PyDict_GetItemWithError(STORE_CACHE, path);
+    if (world) return (PyFeatures*)Python::newRef(world);
+    if (PyErr_Occurred()) return NULL;
+
+    world = PyObject_CallOneArg((PyObject*)&TYPE, path);
+    if (!world) return NULL;
+    if (PyDict_SetItem(STORE_CACHE, path, world) < 0)
+    {
+        Py_DECREF(world);
+        return NULL;
+    }
+    return (PyFeatures*)world;
+}
+
+void PyFeatures::clearStoreCache()
+{
+    Py_CLEAR(STORE_CACHE);
+}
+
+PyObject* PyFeatures::reduce(PyFeatures* self, PyObject* unused)
+{
+    bool empty = self->selectionType == &Empty::SUBTYPE;
+    if (!empty && self->selectionType != &World::SUBTYPE)
+    {
+        PyErr_SetString(PyExc_TypeError,
+            "Cannot pickle a selection of related features "
+            "(members, nodes or parents)");
+        return NULL;
+    }
+    if (self->filter)
+    {
+        // Filters can't be turned back into the calls that created them,
+        // so rather than silently dropping them, we refuse
+        PyObject* pickle = PyImport_ImportModule("pickle");
+        if (!pickle) return NULL;
+        PyObject* error = PyObject_GetAttrString(pickle, "PicklingError");
+        Py_DECREF(pickle);
+        if (!error) return NULL;
+        PyErr_SetString(error,
+            "Cannot pickle a selection with a spatial or custom filter");
+        Py_DECREF(error);
+        return NULL;
+    }
+    PyObject* restoreFunc = PyObject_GetAttrString(
+        Environment::get().getGeodeskModule(), "_restore_features");
+    if (!restoreFunc) return NULL;
+
+    const std::string& path = StoreState::of(self->store)->absolutePath();
+    PyObject* bounds;
+    if (!empty && (self->flags & SelectionFlags::BOUNDS_ACTIVE))
+    {
+        const Box& b = self->bounds;
+        bounds = Py_BuildValue("(iiii)", b.minX(), b.minY(), b.maxX(), b.maxY());
+    }
+    else
+    {
+        bounds = Python::newRef(Py_None);
+    }
+    if (!bounds)
+    {
+        Py_DECREF(restoreFunc);
+        return NULL;
+    }
+    return Py_BuildValue("(N(s#ONI))", restoreFunc,
+        path.data(), (Py_ssize_t)path.size(),
+        (self->queries && !empty) ? self->queries : Py_None, bounds,
+        empty ? 0u : (uint32_t)self->acceptedTypes);
+}
+
+PyObject* PyFeatures::restore(PyObject* module, PyObject* args)
+{
+    PyObject* path;
+    PyObject* queries;
+    PyObject* bounds;
+    unsigned int types;
+    if (!PyArg_ParseTuple(args, "UOOI", &path, &queries, &bounds, &types))
+    {
+        return NULL;
+    }
+    PyFeatures* features = openCached(path);
+    if (!features) return NULL;
+    if (queries != Py_None)
+    {
+        if (!PyTuple_Check(queries))
+        {
+            Py_DECREF(features);
+            PyErr_SetString(PyExc_TypeError, "Expected tuple of queries");
+            return NULL;
+        }
+        for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(queries); i++)
+        {
+            const char* query = PyUnicode_AsUTF8(PyTuple_GET_ITEM(queries, i));
+            PyFeatures* next = query ? features->withQuery(query) : NULL;
+            Py_DECREF(features);
+            if (!next) return NULL;
+            features = next;
+        }
+    }
+    if (bounds != Py_None)
+    {
+        int minX, minY, maxX, maxY;
+        if (!PyArg_ParseTuple(bounds, "iiii", &minX, &minY, &maxX, &maxY))
+        {
+            Py_DECREF(features);
+            return NULL;
+        }
+        if (features->selectionType == &World::SUBTYPE)
+        {
+            Box box(minX, minY, maxX, maxY);
+            features->matcher->addref();
+            PyFeatures* next = createWith(features,
+                features->flags | SelectionFlags::BOUNDS_ACTIVE,
+                features->acceptedTypes, &box, features->matcher, nullptr);
+            Py_DECREF(features);
+            if (!next) return NULL;
+            features = next;
+        }
+    }
+    PyFeatures* result = features->withTypes(types);
+    Py_DECREF(features);
+    return result;
+}
+
+PyMethodDef PyFeatures::METHODS[] =
+{
+    { "__reduce__", (PyCFunction)reduce, METH_NOARGS, "Supports pickling" },
+    { NULL, NULL, 0, NULL },
+};
@@ -0,0 +1,267 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "PyFeatures.h"
+#include <algorithm>
+#include <cstring>
+#include <queue>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "python/feature/PyFeature.h"
+#include "python/util/util.h"
+#include "QueryScan.h"
+#include "TileRanges.h"
+
+// We sample by assigning each feature a pseudo-random key derived from
+// its ID and the seed, and keeping the n features with the lowest keys
+// (a reservoir that is a bounded max-heap). Unlike classic reservoir
+// sampling, the result doesn't depend on the order in which the query
+// returns features, or on how they are split among threads, so the
+// per-thread reservoirs can simply be merged, and a given seed always
+// yields the same sample.
+//
+// Every feature of the selection is still visited (the GOL has no
+// per-tile counts for arbitrary filters, so we can't skip whole tiles);
+// the savings come from not turning the rest of the selection into
+// Feature objects.
+
+namespace {
+
+struct Candidate
+{
+    uint64_t key;
+    FeaturePtr feature;
+
+    bool operator<(const Candidate& other) const { return key < other.key; }
+};
+
+uint64_t mix(uint64_t x)
+{
+    // splitmix64 finalizer
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+uint64_t sampleKey(uint64_t seed, FeaturePtr feature)
+{
+    return mix(seed ^ mix(feature.idBits() * 4 + feature.typeCode()));
+}
+
+class Reservoir
+{
+public:
+    explicit Reservoir(size_t capacity) : capacity_(capacity) {}
+
+    void add(uint64_t key, FeaturePtr feature)
+    {
+        if (heap_.size() < capacity_)
+        {
+            heap_.push({ key, feature });
+        }
+        else if (key < heap_.top().key)
+        {
+            heap_.pop();
+            heap_.push({ key, feature });
+        }
+    }
+
+    void moveTo(std::vector<Candidate>& candidates)
+    {
+        while (!heap_.empty())
+        {
+            candidates.push_back(heap_.top());
+            heap_.pop();
+        }
+    }
+
+private:
+    size_t capacity_;
+    std::priority_queue<Candidate> heap_;
+};
+
+struct TileSample
+{
+    explicit TileSample(size_t capacity) : reservoir(capacity), count(0) {}
+
+    Reservoir reservoir;
+    uint64_t count;
+};
+
+/// Takes the `n` candidates with the lowest keys, in key order
+void selectLowest(std::vector<Candidate>& candidates, size_t n)
+{
+    if (candidates.size() > n)
+    {
+        std::nth_element(candidates.begin(), candidates.begin() + n, candidates.end());
+        candidates.resize(n);
+    }
+    std::sort(candidates.begin(), candidates.end());
+}
+
+}
+
+
+PyObject* PyFeatures::sample(PyFeatures* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* KEYWORDS[] = { "n", "seed", "stratify", nullptr };
+    Py_ssize_t n;
+    PyObject* seedArg = Py_None;
+    PyObject* stratifyArg = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "n|$OO:sample", (char**)KEYWORDS,
+        &n, &seedArg, &stratifyArg))
+    {
+        return NULL;
+    }
+    if (n < 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "n must not be negative");
+        return NULL;
+    }
+    uint64_t seed;
+    if (seedArg == Py_None)
+    {
+        std::random_device random;
+        seed = (static_cast<uint64_t>(random()) << 32) | random();
+    }
+    else
+    {
+        seed = PyLong_AsUnsignedLongLongMask(seedArg);
+        if (PyErr_Occurred()) return NULL;
+    }
+    bool stratify = false;
+    if (stratifyArg != Py_None)
+    {
+        const char* s = PyUnicode_Check(stratifyArg) ? PyUnicode_AsUTF8(stratifyArg) : nullptr;
+        if (!s || strcmp(s, "tile") != 0)
+        {
+            if (!PyErr_Occurred())
+            {
+                PyErr_SetString(PyExc_ValueError, "stratify must be None or 'tile'");
+            }
+            return NULL;
+        }
+        stratify = true;
+    }
+
+    bool world = self->selectionType == &World::SUBTYPE;
+    if (!world && self->selectionType != &Empty::SUBTYPE)
+    {
+        PyErr_SetString(PyExc_TypeError,
+            "sample() is not supported for selections of related "
+            "features (members, nodes or parents)");
+        return NULL;
+    }
+    if (!world || n == 0) return PyList_New(0);
+
+    std::vector<Candidate> sample;
+    QueryScan scan(self);
+    int slots = scan.slotCount();
+    if (!stratify)
+    {
+        std::vector<Reservoir> reservoirs(slots, Reservoir(n));
+        if (!scan.run([&](int slot, const FeaturePtr* features, size_t count)
+            {
+                Reservoir& reservoir = reservoirs[slot];
+                for (size_t i = 0; i < count; i++)
+                {
+                    reservoir.add(sampleKey(seed, features[i]), features[i]);
+                }
+            }))
+        {
+            return NULL;
+        }
+        for (Reservoir& reservoir : reservoirs) reservoir.moveTo(sample);
+        selectLowest(sample, n);
+    }
+    else
+    {
+        // Each tile gets its own reservoir (and count), and contributes
+        // to the sample in proportion to its share of the selection.
+        // Workers only keep reservoirs for the tiles they have seen
+        // features of, so memory is bounded by the visited tiles
+        TileRanges tiles(self->store, self->bounds, self->filter);
+        size_t tileCount = tiles.size();
+        std::vector<std::unordered_map<size_t,TileSample>> tileSamples(slots);
+        if (!scan.run([&](int slot, const FeaturePtr* features, size_t count)
+            {
+                std::unordered_map<size_t,TileSample>& slotSamples = tileSamples[slot];
+                for (size_t i = 0; i < count; i++)
+                {
+                    ptrdiff_t tile = tiles.tileOf(features[i]);
+                    if (tile < 0) continue;
+                    TileSample& tileSample = slotSamples.try_emplace(tile, n).first->second;
+                    tileSample.reservoir.add(sampleKey(seed, features[i]), features[i]);
+                    tileSample.count++;
+                }
+            }))
+        {
+            return NULL;
+        }
+
+        std::vector<uint64_t> tileCounts(tileCount);
+        uint64_t total = 0;
+        for (const auto& slotSamples : tileSamples)
+        {
+            for (const auto& [tile, tileSample] : slotSamples)
+            {
+                tileCounts[tile] += tileSample.count;
+                total += tileSample.count;
+            }
+        }
+
+        // Allocate the sample among the tiles by largest remainder
+        size_t wanted = std::min(static_cast<uint64_t>(n), total);
+        std::vector<size_t> quotas(tileCount);
+        std::vector<std::pair<uint64_t,size_t>> remainders;
+        size_t allocated = 0;
+        for (size_t i = 0; i < tileCount; i++)
+        {
+            if (tileCounts[i] == 0) continue;
+            uint64_t share = tileCounts[i] * wanted;
+            quotas[i] = share / total;
+            allocated += quotas[i];
+            remainders.emplace_back(share % total, i);
+        }
+        std::sort(remainders.begin(), remainders.end(),
+            [](const auto& a, const auto& b) { return a.first > b.first; });
+        for (size_t i = 0; allocated < wanted; i++)
+        {
+            quotas[remainders[i].second]++;
+            allocated++;
+        }
+
+        std::vector<Candidate> candidates;
+        for (size_t i = 0; i < tileCount; i++)
+        {
+            if (quotas[i] == 0) continue;
+            candidates.clear();
+            for (auto& slotSamples : tileSamples)
+            {
+                auto it = slotSamples.find(i);
+                if (it != slotSamples.end()) it->second.reservoir.moveTo(candidates);
+            }
+            selectLowest(candidates, quotas[i]);
+            sample.insert(sample.end(), candidates.begin(), candidates.end());
+        }
+        std::sort(sample.begin(), sample.end());
+    }
+
+    PyObject* list = PyList_New(sample.size());
+    if (!list) return NULL;
+    for (size_t i = 0; i < sample.size(); i++)
+    {
+        PyObject* feature = PyFeature::create(self->store, sample[i].feature, Py_None);
+        if (!feature)
+        {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, feature);
+    }
+    return list;
+}
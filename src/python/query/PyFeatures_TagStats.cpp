@@ -0,0 +1,184 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "PyFeatures.h"
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "python/feature/TagReader.h"
+#include "python/util/util.h"
+#include "QueryScan.h"
+
+// The workers count global strings by their codes, numbers by their raw
+// encoded form, and local strings by their text (a view into the tile
+// data, which stays mapped while the store is open). Distinct values
+// are turned into text only once all counts have been merged, and Python
+// strings are created only for the result.
+
+namespace {
+
+struct ValueCounts
+{
+    std::unordered_map<int,uint64_t> globalStrings;
+    std::unordered_map<uint64_t,uint64_t> numbers;
+    std::unordered_map<std::string_view,uint64_t> localStrings;
+};
+
+/// Key counts by key text (a view into the string table or the tile
+/// data, which stay mapped while the store is open)
+using KeyCounts = std::unordered_map<std::string_view,uint64_t>;
+
+/// Creates a dict of the given counts, ordered by descending
+/// count (ties are ordered alphabetically)
+PyObject* createCountDict(const std::unordered_map<std::string,uint64_t>& counts)
+{
+    std::vector<std::pair<const std::string*,uint64_t>> sorted;
+    sorted.reserve(counts.size());
+    for (const auto& [s, count] : counts) sorted.emplace_back(&s, count);
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b)
+        {
+            if (a.second != b.second) return a.second > b.second;
+            return *a.first < *b.first;
+        });
+
+    PyObject* dict = PyDict_New();
+    if (!dict) return NULL;
+    for (const auto& [s, count] : sorted)
+    {
+        PyObject* keyObj = PyUnicode_FromStringAndSize(s->data(), s->size());
+        PyObject* countObj = keyObj ? PyLong_FromUnsignedLongLong(count) : NULL;
+        int res = countObj ? PyDict_SetItem(dict, keyObj, countObj) : -1;
+        Py_XDECREF(keyObj);
+        Py_XDECREF(countObj);
+        if (res < 0)
+        {
+            Py_DECREF(dict);
+            return NULL;
+        }
+    }
+    return dict;
+}
+
+bool checkTagStatsSelection(PyFeatures* self, const char* method)
+{
+    if (self->selectionType == &PyFeatures::World::SUBTYPE ||
+        self->selectionType == &PyFeatures::Empty::SUBTYPE)
+    {
+        return true;
+    }
+    PyErr_Format(PyExc_TypeError,
+        "%s() is not supported for selections of related "
+        "features (members, nodes or parents)", method);
+    return false;
+}
+
+}
+
+
+PyObject* PyFeatures::distinct(PyFeatures* self, PyObject* args, PyObject* kwargs)
+{
+    PyObject* keyObj = Python::checkSingleArg(args, kwargs, &PyUnicode_Type);
+    if (!keyObj) return NULL;
+    if (!checkTagStatsSelection(self, "distinct")) return NULL;
+    TagReader reader;
+    if (!reader.init(self->store, keyObj)) return NULL;
+
+    std::unordered_map<std::string,uint64_t> totals;
+    if (self->selectionType == &World::SUBTYPE)
+    {
+        QueryScan scan(self);
+        std::vector<ValueCounts> counts(scan.slotCount());
+        if (!scan.run([&](int slot, const FeaturePtr* features, size_t count)
+            {
+                ValueCounts& slotCounts = counts[slot];
+                for (size_t i = 0; i < count; i++)
+                {
+                    TagReader::Value value = reader.get(features[i].tags());
+                    switch (value.type)
+                    {
+                    case TagReader::MISSING:
+                        break;
+                    case TagReader::GLOBAL_STRING:
+                        slotCounts.globalStrings[TagReader::globalCode(value)]++;
+                        break;
+                    case TagReader::LOCAL_STRING:
+                        slotCounts.localStrings[reader.toStringView(value)]++;
+                        break;
+                    default:
+                        slotCounts.numbers[(static_cast<uint64_t>(value.type) << 32) |
+                            TagReader::rawNumber(value)]++;
+                        break;
+                    }
+                }
+            }))
+        {
+            return NULL;
+        }
+
+        // Each worker counted the same values separately; merge by text
+        StringTable& strings = self->store->strings();
+        for (const ValueCounts& slotCounts : counts)
+        {
+            for (const auto& [code, count] : slotCounts.globalStrings)
+            {
+                totals[std::string(strings.getGlobalString(code)->toStringView())] += count;
+            }
+            for (const auto& [number, count] : slotCounts.numbers)
+            {
+                totals[TagReader::formatNumber(static_cast<int>(number >> 32),
+                    static_cast<uint32_t>(number))] += count;
+            }
+            for (const auto& [s, count] : slotCounts.localStrings)
+            {
+                totals[std::string(s)] += count;
+            }
+        }
+    }
+    return createCountDict(totals);
+}
+
+
+PyObject* PyFeatures::key_stats(PyFeatures* self, PyObject* args, PyObject* kwargs)
+{
+    if (!PyArg_ParseTuple(args, ":key_stats")) return NULL;
+    if (kwargs && PyDict_GET_SIZE(kwargs))
+    {
+        PyErr_SetString(PyExc_TypeError, "key_stats() takes no keyword arguments");
+        return NULL;
+    }
+    if (!checkTagStatsSelection(self, "key_stats")) return NULL;
+
+    std::unordered_map<std::string,uint64_t> totals;
+    if (self->selectionType == &World::SUBTYPE)
+    {
+        QueryScan scan(self);
+        std::vector<KeyCounts> counts(scan.slotCount());
+        StringTable& strings = self->store->strings();
+        if (!scan.run([&](int slot, const FeaturePtr* features, size_t count)
+            {
+                KeyCounts& slotCounts = counts[slot];
+                for (size_t i = 0; i < count; i++)
+                {
+                    TagReader::forEachTag(features[i].tags(), strings,
+                        [&slotCounts](std::string_view key, TagReader::Value)
+                        {
+                            slotCounts[key]++;
+                        });
+                }
+            }))
+        {
+            return NULL;
+        }
+
+        for (const KeyCounts& slotCounts : counts)
+        {
+            for (const auto& [s, count] : slotCounts)
+            {
+                totals[std::string(s)] += count;
+            }
+        }
+    }
+    return createCountDict(totals);
+}
@@ -0,0 +1,184 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "PyFeatures.h"
+#include <optional>
+#include <vector>
+#include "python/util/PyNumArray.h"
+#include "python/util/util.h"
+#include "QueryScan.h"
+#include "TileRanges.h"
+
+// Columns of the result of tile_stats(), in order
+static const struct
+{
+    const char* name;
+    char format;
+}
+TILE_STATS_COLUMNS[] =
+{
+    { "tip", 'I' },
+    { "zoom", 'i' },
+    { "column", 'i' },
+    { "row", 'i' },
+    { "nodes", 'I' },
+    { "ways", 'I' },
+    { "relations", 'I' },
+    { "foreign_relations", 'I' },
+    { "exports", 'I' },
+    { "size", 'I' },
+    { "revision", 'I' },
+};
+
+enum TileStatsColumn
+{
+    TIP, ZOOM, COLUMN, ROW, NODES, WAYS, RELATIONS, FOREIGN_RELATIONS,
+    EXPORTS, SIZE, REVISION, COLUMN_COUNT
+};
+
+PyObject* PyFeatures::tile_stats(PyFeatures* self, PyObject* args, PyObject* kwargs)
+{
+    if (!PyArg_ParseTuple(args, ":tile_stats")) return NULL;
+    if (kwargs && PyDict_GET_SIZE(kwargs))
+    {
+        PyErr_SetString(PyExc_TypeError, "tile_stats() takes no keyword arguments");
+        return NULL;
+    }
+    bool world = self->selectionType == &World::SUBTYPE;
+    if (!world && self->selectionType != &Empty::SUBTYPE)
+    {
+        PyErr_SetString(PyExc_TypeError,
+            "tile_stats() is not supported for selections of related "
+            "features (members, nodes or parents)");
+        return NULL;
+    }
+
+    FeatureStore* store = self->store;
+    std::optional<TileRanges> tiles;
+    if (world) tiles.emplace(store, self->bounds, self->filter);
+    size_t tileCount = tiles ? tiles->size() : 0;
+
+    PyNumArray* columns[COLUMN_COUNT];
+    for (int i = 0; i < COLUMN_COUNT; i++)
+    {
+        columns[i] = PyNumArray::create(TILE_STATS_COLUMNS[i].format, tileCount);
+        if (!columns[i])
+        {
+            for (int i2 = 0; i2 < i; i2++) Py_DECREF(columns[i2]);
+            return NULL;
+        }
+    }
+    uint32_t* tips = columns[TIP]->values<uint32_t>();
+    int32_t* zooms = columns[ZOOM]->values<int32_t>();
+    int32_t* cols = columns[COLUMN]->values<int32_t>();
+    int32_t* rows = columns[ROW]->values<int32_t>();
+    uint32_t* exports = columns[EXPORTS]->values<uint32_t>();
+    uint32_t* sizes = columns[SIZE]->values<uint32_t>();
+    uint32_t* revisions = columns[REVISION]->values<uint32_t>();
+
+    for (size_t i = 0; i < tileCount; i++)
+    {
+        Tile tile = tiles->tile(i);
+        Tip tip = tiles->tip(i);
+        tips[i] = tip;
+        zooms[i] = tile.zoom();
+        cols[i] = tile.column();
+        rows[i] = tile.row();
+        TilePtr pTile = store->fetchTile(tip);
+        if (!pTile) continue;
+        ExportTablePtr pExports = pTile.exports();
+        exports[i] = pExports ? pExports.count() : 0;
+        sizes[i] = pTile.totalSize();
+        revisions[i] = pTile.revision();
+    }
+
+    if (tileCount > 0)
+    {
+        // Each feature is returned by the query only once, and we count
+        // it for the tile that holds the copy that was returned (the same
+        // tile that Tile.features assigns it to). Checking relations for
+        // foreign members requires the GIL (the member iterator may
+        // need to look up role strings), so we collect them and check
+        // them after the scan.
+        QueryScan scan(self);
+        int slots = scan.slotCount();
+        std::vector<std::vector<uint32_t>> counts(slots);
+        std::vector<std::vector<std::pair<FeaturePtr,size_t>>> relations(slots);
+        if (!scan.run([&](int slot, const FeaturePtr* features, size_t count)
+            {
+                std::vector<uint32_t>& slotCounts = counts[slot];
+                if (slotCounts.empty()) slotCounts.resize(tileCount * 3);
+                for (size_t i = 0; i < count; i++)
+                {
+                    FeaturePtr f = features[i];
+                    ptrdiff_t tile = tiles->tileOf(f);
+                    if (tile < 0) continue;
+                    if (f.isNode())
+                    {
+                        slotCounts[tile * 3]++;
+                    }
+                    else if (f.isWay())
+                    {
+                        slotCounts[tile * 3 + 1]++;
+                    }
+                    else
+                    {
+                        slotCounts[tile * 3 + 2]++;
+                        relations[slot].emplace_back(f, tile);
+                    }
+                }
+            }))
+        {
+            for (int i = 0; i < COLUMN_COUNT; i++) Py_DECREF(columns[i]);
+            return NULL;
+        }
+
+        uint32_t* nodeCounts = columns[NODES]->values<uint32_t>();
+        uint32_t* wayCounts = columns[WAYS]->values<uint32_t>();
+        uint32_t* relationCounts = columns[RELATIONS]->values<uint32_t>();
+        uint32_t* foreignCounts = columns[FOREIGN_RELATIONS]->values<uint32_t>();
+        for (const std::vector<uint32_t>& slotCounts : counts)
+        {
+            if (slotCounts.empty()) continue;
+            for (size_t i = 0; i < tileCount; i++)
+            {
+                nodeCounts[i] += slotCounts[i * 3];
+                wayCounts[i] += slotCounts[i * 3 + 1];
+                relationCounts[i] += slotCounts[i * 3 + 2];
+            }
+        }
+        for (const auto& slotRelations : relations)
+        {
+            for (const auto& [relation, tile] : slotRelations)
+            {
+                MemberIterator iter(store, relation.bodyptr(), FeatureTypes::ALL,
+                    store->borrowAllMatcher(), nullptr);
+                for (;;)
+                {
+                    FeaturePtr member = iter.next();
+                    if (member.isNull()) break;
+                    if (iter.isForeign())
+                    {
+                        foreignCounts[tile]++;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    PyObject* dict = PyDict_New();
+    if (dict)
+    {
+        for (int i = 0; i < COLUMN_COUNT; i++)
+        {
+            if (PyDict_SetItemString(dict, TILE_STATS_COLUMNS[i].name, columns[i]) < 0)
+            {
+                Py_CLEAR(dict);
+                break;
+            }
+        }
+    }
+    for (int i = 0; i < COLUMN_COUNT; i++) Py_DECREF(columns[i]);
+    return dict;
+}
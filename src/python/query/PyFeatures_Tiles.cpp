@@ -0,0 +1,103 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "PyFeatures.h"
+#include <geodesk/filter/ComboFilter.h>
+#include "python/util/util.h"
+#include "TileFilter.h"
+
+PyFeatures* PyFeatures::withTile(Tile tile, Tip tip)
+{
+    if (selectionType != &World::SUBTYPE)
+    {
+        if (selectionType == &Empty::SUBTYPE) return Python::newRef(this);
+        PyErr_SetString(PyExc_TypeError,
+            "Only a selection of features by query or bounding box "
+            "can be restricted to a tile");
+        return NULL;
+    }
+
+    const Filter* newFilter = new TileFilter(store, tile, tip, bounds);
+    if (filter)
+    {
+        const ComboFilter* combo = new ComboFilter(filter, newFilter);
+        newFilter->release();   // ComboFilter holds its own ref
+        newFilter = combo;
+    }
+
+    // The query itself only needs to look at the tile's area; the
+    // TileFilter still applies the de-duplication rule against the
+    // original bounds
+    Box box = Box::simpleIntersection(bounds, tile.bounds());
+    matcher->addref();      // createWith consumes ref to matcher
+    return createWith(this, flags | USES_FILTER | BOUNDS_ACTIVE,
+        acceptedTypes, &box, matcher, newFilter);
+}
+
+
+PyObject* PyFeatures::tileFeatures(PyObject* module, PyObject* args)
+{
+    PyObject* features;
+    unsigned int tip;
+    int column, row, zoom;
+    if (!PyArg_ParseTuple(args, "O!Iiii", &TYPE, &features, &tip,
+        &column, &row, &zoom))
+    {
+        return NULL;
+    }
+    if (zoom < 0 || zoom > 12 || column < 0 || row < 0 ||
+        column >= (1 << zoom) || row >= (1 << zoom))
+    {
+        PyErr_SetString(PyExc_ValueError, "Invalid tile");
+        return NULL;
+    }
+    return ((PyFeatures*)features)->withTile(
+        Tile::fromColumnRowZoom(column, row, zoom), Tip(tip));
+}
+
+
+PyObject* PyFeatures::parallel_map(PyFeatures* self, PyObject* args, PyObject* kwargs)
+{
+    // Fail early (rather than once the results are consumed)
+    // if the workers won't be able to recreate the selection
+    if (self->selectionType != &World::SUBTYPE &&
+        self->selectionType != &Empty::SUBTYPE)
+    {
+        PyErr_SetString(PyExc_TypeError,
+            "parallel_map() is not supported for selections of related "
+            "features (members, nodes or parents)");
+        return NULL;
+    }
+    if (self->filter)
+    {
+        PyErr_SetString(PyExc_TypeError,
+            "parallel_map() is not supported for selections with "
+            "a spatial or custom filter");
+        return NULL;
+    }
+
+    // The process pool and the streaming of results are handled
+    // by geodesk._parallel
+    PyObject* module = PyImport_ImportModule("geodesk._parallel");
+    if (!module) return NULL;
+    PyObject* func = PyObject_GetAttrString(module, "parallel_map");
+    Py_DECREF(module);
+    if (!func) return NULL;
+
+    Py_ssize_t argCount = PyTuple_GET_SIZE(args);
+    PyObject* fullArgs = PyTuple_New(argCount + 1);
+    if (!fullArgs)
+    {
+        Py_DECREF(func);
+        return NULL;
+    }
+    PyTuple_SET_ITEM(fullArgs, 0, Python::newRef(self));
+    for (Py_ssize_t i = 0; i < argCount; i++)
+    {
+        PyTuple_SET_ITEM(fullArgs, i + 1, Python::newRef(PyTuple_GET_ITEM(args, i)));
+    }
+    PyObject* result = PyObject_Call(func, fullArgs, kwargs);
+    Py_DECREF(fullArgs);
+    Py_DECREF(func);
+    return result;
+}
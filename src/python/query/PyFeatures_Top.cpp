@@ -0,0 +1,182 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "PyFeatures.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <vector>
+#include <geodesk/geom/Area.h>
+#include <geodesk/geom/Length.h>
+#include "python/feature/PyFeature.h"
+#include "python/feature/TagReader.h"
+#include "python/util/util.h"
+#include "QueryScan.h"
+
+namespace {
+
+enum class TopMeasure
+{
+    TAG,
+    LENGTH,
+    AREA
+};
+
+struct Ranked
+{
+    double value;
+    FeaturePtr feature;
+
+    /// Orders by value, then by type and ID (so ties are broken the
+    /// same way regardless of how the query split up the work)
+    bool operator>(const Ranked& other) const
+    {
+        if (value != other.value) return value > other.value;
+        if (feature.typeCode() != other.feature.typeCode())
+        {
+            return feature.typeCode() < other.feature.typeCode();
+        }
+        return feature.id() < other.feature.id();
+    }
+};
+
+/// Keeps the k highest-ranked features seen so far (a bounded min-heap)
+class TopList
+{
+public:
+    explicit TopList(size_t capacity) : capacity_(capacity) {}
+
+    void add(double value, FeaturePtr feature)
+    {
+        Ranked candidate{ value, feature };
+        if (heap_.size() < capacity_)
+        {
+            heap_.push(candidate);
+        }
+        else if (candidate > heap_.top())
+        {
+            heap_.pop();
+            heap_.push(candidate);
+        }
+    }
+
+    void moveTo(std::vector<Ranked>& ranked)
+    {
+        while (!heap_.empty())
+        {
+            ranked.push_back(heap_.top());
+            heap_.pop();
+        }
+    }
+
+private:
+    size_t capacity_;
+    std::priority_queue<Ranked, std::vector<Ranked>, std::greater<Ranked>> heap_;
+};
+
+}
+
+
+PyObject* PyFeatures::top(PyFeatures* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* KEYWORDS[] = { "k", "by", nullptr };
+    Py_ssize_t k;
+    PyObject* byArg;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "nU:top", (char**)KEYWORDS,
+        &k, &byArg))
+    {
+        return NULL;
+    }
+    if (k < 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "k must not be negative");
+        return NULL;
+    }
+    const char* by = PyUnicode_AsUTF8(byArg);
+    if (!by) return NULL;
+
+    bool world = self->selectionType == &World::SUBTYPE;
+    if (!world && self->selectionType != &Empty::SUBTYPE)
+    {
+        PyErr_SetString(PyExc_TypeError,
+            "top() is not supported for selections of related "
+            "features (members, nodes or parents)");
+        return NULL;
+    }
+
+    // "length" and "area" refer to the measures; anything else is a key
+    // (Features that lack the tag, or whose value isn't a number, are
+    // skipped; likewise, nodes aren't ranked by length, and only areas
+    // are ranked by area)
+    TopMeasure measure = TopMeasure::TAG;
+    if (strcmp(by, "length") == 0)
+    {
+        measure = TopMeasure::LENGTH;
+    }
+    else if (strcmp(by, "area") == 0)
+    {
+        measure = TopMeasure::AREA;
+    }
+    TagReader reader;
+    if (measure == TopMeasure::TAG && !reader.init(self->store, byArg)) return NULL;
+
+    if (!world || k == 0) return PyList_New(0);
+
+    QueryScan scan(self);
+    std::vector<TopList> lists(scan.slotCount(), TopList(k));
+    FeatureStore* store = self->store;
+    if (!scan.run([&](int slot, const FeaturePtr* features, size_t count)
+        {
+            TopList& list = lists[slot];
+            for (size_t i = 0; i < count; i++)
+            {
+                FeaturePtr f = features[i];
+                double value;
+                switch (measure)
+                {
+                case TopMeasure::TAG:
+                    if (!reader.toNumber(reader.get(f.tags()), value)) continue;
+                    break;
+                case TopMeasure::LENGTH:
+                    if (f.isNode()) continue;
+                    value = f.isWay() ? Length::ofWay(WayPtr(f)) :
+                        Length::ofRelation(store, RelationPtr(f));
+                    break;
+                case TopMeasure::AREA:
+                    if (!f.isArea()) continue;
+                    value = f.isWay() ? Area::ofWay(WayPtr(f)) :
+                        Area::ofRelation(store, RelationPtr(f));
+                    break;
+                }
+                list.add(value, f);
+            }
+        }))
+    {
+        return NULL;
+    }
+
+    std::vector<Ranked> ranked;
+    for (TopList& list : lists) list.moveTo(ranked);
+    if (ranked.size() > static_cast<size_t>(k))
+    {
+        std::nth_element(ranked.begin(), ranked.begin() + k, ranked.end(),
+            std::greater<Ranked>());
+        ranked.resize(k);
+    }
+    std::sort(ranked.begin(), ranked.end(), std::greater<Ranked>());
+
+    PyObject* list = PyList_New(ranked.size());
+    if (!list) return NULL;
+    for (size_t i = 0; i < ranked.size(); i++)
+    {
+        PyObject* feature = PyFeature::create(self->store, ranked[i].feature, Py_None);
+        if (!feature)
+        {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, feature);
+    }
+    return list;
+}
@@ -1,4 +1,4 @@
-static const int ATTR_COUNT = 52;
+static const int ATTR_COUNT = 69;
 static const char* ATTR_NAMES[] =
 {
     "area",
@@ -6,6 +6,7 @@ static const char* ATTR_NAMES[] =
     "first",
     "geojson",
     "geojsonl",
+    "geometry_cache_stats",
     "guid",
     "indexed_keys",
     "length",
@@ -14,6 +15,7 @@ static const char* ATTR_NAMES[] =
     "nodes",
     "one",
     "properties",
+    "queue_stats",
     "refcount",
     "relations",
     "revision",
@@ -23,9 +25,22 @@ static const char* ATTR_NAMES[] =
     "timestamp",
     "ways",
     "wkt",
+    "accessor",
+    "acount",
+    "afirst",
+    "aiter",
     "auto_load",
+    "distances",
+    "distinct",
     "explain",
+    "grid",
+    "key_stats",
     "load",
+    "num_array",
+    "parallel_map",
+    "sample",
+    "tile_stats",
+    "top",
     "update",
     "ancestors_of",
     "around",
@@ -36,6 +51,7 @@ static const char* ATTR_NAMES[] =
     "descendants_of",
     "disjoint_from",
     "filter",
+    "in_set",
     "intersecting",
     "max_area",
     "max_length",
@@ -51,6 +67,7 @@ static const char* ATTR_NAMES[] =
     "relation",
     "touching",
     "way",
+    "with_ids",
     "with_role",
     "within",
 };
\ No newline at end of file
@@ -1,6 +1,6 @@
 /* C++ code produced by gperf version 3.1 */
 /* Command-line: 'C:\\dev\\geodesk-py\\tools\\gperf' -L C++ -t --class-name=PyFeatures_AttrHash --lookup-function-name=lookup PyFeatures_attr.txt  */
-/* Computed positions: -k'3-4' */
+/* Computed positions: -k'1-2,5' */
 
 #if !((' ' == 32) && ('!' == 33) && ('"' == 34) && ('#' == 35) \
       && ('%' == 37) && ('&' == 38) && ('\'' == 39) && ('(' == 40) \
@@ -41,12 +41,12 @@
 #line 10 "PyFeatures_attr.txt"
 struct PyFeaturesAttribute { const char *name; Python::AttrRef attr; };
 
-#define TOTAL_KEYWORDS 52
+#define TOTAL_KEYWORDS 69
 #define MIN_WORD_LENGTH 3
-#define MAX_WORD_LENGTH 15
-#define MIN_HASH_VALUE 3
-#define MAX_HASH_VALUE 82
-/* maximum key range = 80, duplicates = 0 */
+#define MAX_WORD_LENGTH 20
+#define MIN_HASH_VALUE 7
+#define MAX_HASH_VALUE 172
+/* maximum key range = 166, duplicates = 0 */
 
 class PyFeatures_AttrHash
 {
@@ -61,42 +61,47 @@ PyFeatures_AttrHash::hash (const char *str, size_t len)
 {
   static unsigned char asso_values[] =
     {
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 15, 83,  0, 30,  5,
-      10,  5,  5, 10, 40, 20,  0, 83, 20, 40,
-      35, 35, 10, 83, 25, 20,  0, 25, 25, 83,
-      45, 45, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83, 83, 83, 83, 83,
-      83, 83, 83, 83, 83, 83
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173,   6, 173,  16, 173,  54,
+       54,  47,  51,  11,  37,   3, 173,   3,   0,  13,
+       42,  40,   9,  62,  39,  67,  56,  16,  53,   2,
+       31, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173, 173, 173, 173, 173,
+      173, 173, 173, 173, 173, 173
     };
   unsigned int hval = len;
 
   switch (hval)
     {
       default:
-        hval += asso_values[static_cast<unsigned char>(str[3])];
+        hval += asso_values[static_cast<unsigned char>(str[4])];
       /*FALLTHROUGH*/
+      case 4:
       case 3:
-        hval += asso_values[static_cast<unsigned char>(str[2])];
+      case 2:
+        hval += asso_values[static_cast<unsigned char>(str[1])];
+      /*FALLTHROUGH*/
+      case 1:
+        hval += asso_values[static_cast<unsigned char>(str[0])];
         break;
     }
   return hval;
@@ -107,125 +112,181 @@ PyFeatures_AttrHash::lookup (const char *str, size_t len)
 {
   static struct PyFeaturesAttribute wordlist[] =
     {
-      {""}, {""}, {""},
-#line 33 "PyFeatures_attr.txt"
+      {""}, {""}, {""}, {""}, {""}, {""}, {""},
+#line 21 "PyFeatures_attr.txt"
+      {"list", ATTR_PROPERTY(PyFeatures::list)},
+#line 35 "PyFeatures_attr.txt"
       {"wkt", ATTR_PROPERTY(PyFormatter::wkt)},
+      {""}, {""}, {""}, {""}, {""},
+#line 80 "PyFeatures_attr.txt"
+      {"within",            ATTR_METHOD(filters::within)},
       {""}, {""}, {""}, {""},
-#line 23 "PyFeatures_attr.txt"
-      {"one", ATTR_PROPERTY(PyFeatures::one)},
-#line 12 "PyFeatures_attr.txt"
-      {"area", ATTR_PROPERTY(PyFeatures::area)},
+#line 78 "PyFeatures_attr.txt"
+      {"with_ids",          ATTR_METHOD(filters::with_ids)},
+#line 79 "PyFeatures_attr.txt"
+      {"with_role",         ATTR_METHOD(filters::with_role)},
+#line 77 "PyFeatures_attr.txt"
+      {"way",               ATTR_METHOD(PyFeatures::way)},
+#line 34 "PyFeatures_attr.txt"
+      {"ways", ATTR_PROPERTY(PyFeatures::ways)},
       {""}, {""}, {""},
-#line 21 "PyFeatures_attr.txt"
+#line 69 "PyFeatures_attr.txt"
+      {"min_length",        ATTR_METHOD(filters::min_length)},
+      {""}, {""}, {""}, {""},
+#line 18 "PyFeatures_attr.txt"
+      {"guid", ATTR_PROPERTY(PyFeatures::guid)},
+#line 22 "PyFeatures_attr.txt"
       {"map", ATTR_PROPERTY(PyFeatures::map)},
-#line 36 "PyFeatures_attr.txt"
+      {""}, {""}, {""}, {""},
+#line 48 "PyFeatures_attr.txt"
+      {"parallel_map",      ATTR_METHOD(PyFeatures::parallel_map)},
+      {""},
+#line 65 "PyFeatures_attr.txt"
+      {"max_length",        ATTR_METHOD(filters::max_length)},
+#line 67 "PyFeatures_attr.txt"
+      {"min_area",          ATTR_METHOD(filters::min_area)},
+      {""}, {""}, {""},
+#line 46 "PyFeatures_attr.txt"
       {"load",              ATTR_METHOD(PyFeatures::load)},
-#line 28 "PyFeatures_attr.txt"
-      {"shape", ATTR_PROPERTY(PyFeatures::shape)},
-#line 37 "PyFeatures_attr.txt"
-      {"update",            ATTR_METHOD(PyFeatures::update)},
+      {""}, {""},
+#line 40 "PyFeatures_attr.txt"
+      {"auto_load",         ATTR_METHOD(PyFeatures::auto_load)},
+      {""}, {""}, {""}, {""}, {""},
+#line 64 "PyFeatures_attr.txt"
+      {"max_area",          ATTR_METHOD(filters::max_area)},
+#line 44 "PyFeatures_attr.txt"
+      {"grid",              ATTR_METHOD(PyFeatures::grid)},
+      {""}, {""},
+#line 66 "PyFeatures_attr.txt"
+      {"max_meters_from",   ATTR_METHOD(filters::max_meters_from)},
+      {""},
+#line 12 "PyFeatures_attr.txt"
+      {"area", ATTR_PROPERTY(PyFeatures::area)},
+      {""}, {""}, {""},
+#line 39 "PyFeatures_attr.txt"
+      {"aiter",             ATTR_METHOD(PyFeatures::aiter)},
+      {""}, {""}, {""}, {""},
+#line 42 "PyFeatures_attr.txt"
+      {"distinct",          ATTR_METHOD(PyFeatures::distinct)},
+      {""}, {""}, {""}, {""}, {""}, {""},
+#line 50 "PyFeatures_attr.txt"
+      {"tile_stats",        ATTR_METHOD(PyFeatures::tile_stats)},
+      {""},
+#line 74 "PyFeatures_attr.txt"
+      {"parents_of",        ATTR_METHOD(filters::parents_of)},
+      {""}, {""}, {""}, {""},
+#line 41 "PyFeatures_attr.txt"
+      {"distances",         ATTR_METHOD(PyFeatures::distances)},
 #line 47 "PyFeatures_attr.txt"
-      {"intersecting",      ATTR_METHOD(filters::intersecting)},
-#line 25 "PyFeatures_attr.txt"
-      {"refcount", ATTR_PROPERTY(PyFeatures::refcount)},
-#line 55 "PyFeatures_attr.txt"
+      {"num_array",         ATTR_METHOD(PyFeatures::num_array)},
+      {""},
+#line 24 "PyFeatures_attr.txt"
+      {"one", ATTR_PROPERTY(PyFeatures::one)},
+#line 71 "PyFeatures_attr.txt"
       {"node",              ATTR_METHOD(PyFeatures::node)},
-#line 22 "PyFeatures_attr.txt"
-      {"nodes", ATTR_PROPERTY(PyFeatures::nodes)},
+#line 52 "PyFeatures_attr.txt"
+      {"update",            ATTR_METHOD(PyFeatures::update)},
+#line 19 "PyFeatures_attr.txt"
+      {"indexed_keys", ATTR_PROPERTY(PyFeatures::indexed_keys)},
+#line 49 "PyFeatures_attr.txt"
+      {"sample",            ATTR_METHOD(PyFeatures::sample)},
+      {""}, {""}, {""}, {""}, {""}, {""},
+#line 63 "PyFeatures_attr.txt"
+      {"intersecting",      ATTR_METHOD(filters::intersecting)},
       {""},
-#line 38 "PyFeatures_attr.txt"
-      {"ancestors_of",      ATTR_METHOD(filters::ancestors_of)},
-#line 56 "PyFeatures_attr.txt"
-      {"nodes_of",          ATTR_METHOD(filters::nodes_of)},
-#line 20 "PyFeatures_attr.txt"
-      {"list", ATTR_PROPERTY(PyFeatures::list)},
+#line 62 "PyFeatures_attr.txt"
+      {"in_set",            ATTR_METHOD(filters::in_set)},
+#line 51 "PyFeatures_attr.txt"
+      {"top",               ATTR_METHOD(PyFeatures::top)},
+      {""},
+#line 43 "PyFeatures_attr.txt"
+      {"explain",           ATTR_METHOD(PyFeatures::explain)},
       {""},
-#line 46 "PyFeatures_attr.txt"
-      {"filter",            ATTR_METHOD(filters::pythonFilter)},
-#line 18 "PyFeatures_attr.txt"
-      {"indexed_keys", ATTR_PROPERTY(PyFeatures::indexed_keys)},
-#line 59 "PyFeatures_attr.txt"
-      {"relation",          ATTR_METHOD(PyFeatures::relation)},
-#line 26 "PyFeatures_attr.txt"
-      {"relations", ATTR_PROPERTY(PyFeatures::relations)},
-#line 30 "PyFeatures_attr.txt"
-      {"tiles", ATTR_PROPERTY(PyFeatures::tiles)},
-      {""}, {""},
-#line 45 "PyFeatures_attr.txt"
-      {"disjoint_from",     ATTR_METHOD(filters::disjoint_from)},
-#line 17 "PyFeatures_attr.txt"
-      {"guid", ATTR_PROPERTY(PyFeatures::guid)},
 #line 54 "PyFeatures_attr.txt"
-      {"nearest_to",        ATTR_METHOD(filters::nearest_to)},
+      {"around",            ATTR_METHOD(filters::around)},
+#line 73 "PyFeatures_attr.txt"
+      {"overlapping",       ATTR_METHOD(filters::overlapping)},
+#line 25 "PyFeatures_attr.txt"
+      {"properties", ATTR_PROPERTY(PyFeatures::properties)},
       {""},
-#line 35 "PyFeatures_attr.txt"
-      {"explain",           ATTR_METHOD(PyFeatures::explain)},
+#line 61 "PyFeatures_attr.txt"
+      {"filter",            ATTR_METHOD(filters::pythonFilter)},
+      {""},
+#line 20 "PyFeatures_attr.txt"
+      {"length", ATTR_PROPERTY(PyFeatures::length)},
 #line 60 "PyFeatures_attr.txt"
-      {"touching",          ATTR_METHOD(filters::touching)},
-#line 44 "PyFeatures_attr.txt"
-      {"descendants_of",    ATTR_METHOD(filters::descendants_of)},
-#line 58 "PyFeatures_attr.txt"
-      {"parents_of",        ATTR_METHOD(filters::parents_of)},
+      {"disjoint_from",     ATTR_METHOD(filters::disjoint_from)},
+      {""}, {""}, {""}, {""},
+#line 14 "PyFeatures_attr.txt"
+      {"first", ATTR_PROPERTY(PyFeatures::first)},
+      {""},
+#line 68 "PyFeatures_attr.txt"
+      {"members_of",        ATTR_METHOD(filters::members_of)},
+#line 37 "PyFeatures_attr.txt"
+      {"acount",            ATTR_METHOD(PyFeatures::acount)},
+      {""},
+#line 56 "PyFeatures_attr.txt"
+      {"containing",        ATTR_METHOD(filters::containing)},
+      {""},
 #line 57 "PyFeatures_attr.txt"
-      {"overlapping",       ATTR_METHOD(filters::overlapping)},
+      {"contained_by",      ATTR_METHOD(filters::contained_by)},
+      {""}, {""},
+#line 17 "PyFeatures_attr.txt"
+      {"geometry_cache_stats", ATTR_PROPERTY(PyFeatures::geometry_cache_stats)},
+#line 45 "PyFeatures_attr.txt"
+      {"key_stats",         ATTR_METHOD(PyFeatures::key_stats)},
+      {""}, {""}, {""}, {""},
+#line 32 "PyFeatures_attr.txt"
+      {"tiles", ATTR_PROPERTY(PyFeatures::tiles)},
 #line 15 "PyFeatures_attr.txt"
       {"geojson", ATTR_PROPERTY(PyFormatter::geojson)},
 #line 16 "PyFeatures_attr.txt"
       {"geojsonl", ATTR_PROPERTY(PyFormatter::geojsonl)},
-#line 34 "PyFeatures_attr.txt"
-      {"auto_load",         ATTR_METHOD(PyFeatures::auto_load)},
-#line 41 "PyFeatures_attr.txt"
-      {"containing",        ATTR_METHOD(filters::containing)},
-#line 63 "PyFeatures_attr.txt"
-      {"within",            ATTR_METHOD(filters::within)},
-#line 42 "PyFeatures_attr.txt"
-      {"contained_by",      ATTR_METHOD(filters::contained_by)},
-#line 61 "PyFeatures_attr.txt"
-      {"way",               ATTR_METHOD(PyFeatures::way)},
-#line 62 "PyFeatures_attr.txt"
-      {"with_role",         ATTR_METHOD(filters::with_role)},
-#line 14 "PyFeatures_attr.txt"
-      {"first", ATTR_PROPERTY(PyFeatures::first)},
-#line 19 "PyFeatures_attr.txt"
-      {"length", ATTR_PROPERTY(PyFeatures::length)},
-#line 29 "PyFeatures_attr.txt"
-      {"strings", ATTR_PROPERTY(PyFeatures::strings)},
 #line 27 "PyFeatures_attr.txt"
-      {"revision", ATTR_PROPERTY(PyFeatures::revision)},
-#line 31 "PyFeatures_attr.txt"
+      {"refcount", ATTR_PROPERTY(PyFeatures::refcount)},
+#line 33 "PyFeatures_attr.txt"
       {"timestamp", ATTR_PROPERTY(PyFeatures::timestamp)},
-#line 24 "PyFeatures_attr.txt"
-      {"properties", ATTR_PROPERTY(PyFeatures::properties)},
-      {""}, {""},
-#line 51 "PyFeatures_attr.txt"
-      {"min_area",          ATTR_METHOD(filters::min_area)},
-      {""},
+#line 26 "PyFeatures_attr.txt"
+      {"queue_stats", ATTR_PROPERTY(PyFeatures::queue_stats)},
 #line 53 "PyFeatures_attr.txt"
-      {"min_length",        ATTR_METHOD(filters::min_length)},
+      {"ancestors_of",      ATTR_METHOD(filters::ancestors_of)},
       {""}, {""},
-#line 43 "PyFeatures_attr.txt"
-      {"crossing",          ATTR_METHOD(filters::crossing)},
+#line 38 "PyFeatures_attr.txt"
+      {"afirst",            ATTR_METHOD(PyFeatures::afirst)},
+#line 76 "PyFeatures_attr.txt"
+      {"touching",          ATTR_METHOD(filters::touching)},
+      {""}, {""}, {""},
+#line 36 "PyFeatures_attr.txt"
+      {"accessor",          ATTR_METHOD(PyFeatures::accessor)},
+#line 70 "PyFeatures_attr.txt"
+      {"nearest_to",        ATTR_METHOD(filters::nearest_to)},
+      {""}, {""}, {""},
+#line 75 "PyFeatures_attr.txt"
+      {"relation",          ATTR_METHOD(PyFeatures::relation)},
+#line 28 "PyFeatures_attr.txt"
+      {"relations", ATTR_PROPERTY(PyFeatures::relations)},
       {""},
+#line 55 "PyFeatures_attr.txt"
+      {"connected_to",      ATTR_METHOD(filters::connected_to)},
+#line 23 "PyFeatures_attr.txt"
+      {"nodes", ATTR_PROPERTY(PyFeatures::nodes)},
 #line 13 "PyFeatures_attr.txt"
       {"count", ATTR_PROPERTY(PyFeatures::count)},
-#line 39 "PyFeatures_attr.txt"
-      {"around",            ATTR_METHOD(filters::around)},
-      {""},
-#line 48 "PyFeatures_attr.txt"
-      {"max_area",          ATTR_METHOD(filters::max_area)},
-#line 32 "PyFeatures_attr.txt"
-      {"ways", ATTR_PROPERTY(PyFeatures::ways)},
-#line 49 "PyFeatures_attr.txt"
-      {"max_length",        ATTR_METHOD(filters::max_length)},
-      {""}, {""}, {""}, {""},
-#line 50 "PyFeatures_attr.txt"
-      {"max_meters_from",   ATTR_METHOD(filters::max_meters_from)},
-      {""}, {""}, {""}, {""},
-#line 52 "PyFeatures_attr.txt"
-      {"members_of",        ATTR_METHOD(filters::members_of)},
-      {""},
-#line 40 "PyFeatures_attr.txt"
-      {"connected_to",      ATTR_METHOD(filters::connected_to)}
+#line 30 "PyFeatures_attr.txt"
+      {"shape", ATTR_PROPERTY(PyFeatures::shape)},
+#line 72 "PyFeatures_attr.txt"
+      {"nodes_of",          ATTR_METHOD(filters::nodes_of)},
+      {""}, {""}, {""},
+#line 29 "PyFeatures_attr.txt"
+      {"revision", ATTR_PROPERTY(PyFeatures::revision)},
+#line 59 "PyFeatures_attr.txt"
+      {"descendants_of",    ATTR_METHOD(filters::descendants_of)},
+      {""}, {""}, {""}, {""}, {""},
+#line 58 "PyFeatures_attr.txt"
+      {"crossing",          ATTR_METHOD(filters::crossing)},
+      {""}, {""}, {""},
+#line 31 "PyFeatures_attr.txt"
+      {"strings", ATTR_PROPERTY(PyFeatures::strings)}
     };
 
   if (len <= MAX_WORD_LENGTH && len >= MIN_WORD_LENGTH)
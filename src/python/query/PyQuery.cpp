@@ -2,17 +2,29 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 
 #include "PyQuery.h"
+#include <algorithm>
 #include "python/Environment.h"
 #include "python/feature/PyFeature.h"
 #include "PyFeatures.h"
+#include "StoreState.h"
+
+void PyQuery::init(PyFeatures* features)
+{
+    Py_INCREF(features);
+    target = features;
+    new(&batch)std::vector<FeaturePtr>();
+    batchPos = 0;
+    busy = false;
+    storeState = StoreState::of(features->store);
+}
+
 
 PyQuery* PyQuery::create(PyFeatures* features)
 {
     PyQuery* self = (PyQuery*)TYPE.tp_alloc(&TYPE, 0);
     if (self != nullptr)
     {
-        Py_INCREF(features);
-        self->target = features;
+        self->init(features);
         // initialize Query in-place
         new(&self->query)Query(
             features->store,
@@ -32,8 +44,7 @@ PyQuery* PyQuery::create(PyFeatures* features,
     PyQuery* self = (PyQuery*)TYPE.tp_alloc(&TYPE, 0);
     if (self != nullptr)
     {
-        Py_INCREF(features);
-        self->target = features;
+        self->init(features);
         // initialize Query in-place
         new(&self->query)Query(features->store, box, types, matcher, filter);
     }
@@ -44,9 +55,16 @@ PyQuery* PyQuery::create(PyFeatures* features,
 void PyQuery::dealloc(PyQuery* self)
 {
     // TODO: cancel pending query
-    Py_DECREF(self->target);
-    // ~Query() will block until all pending tile shave been processed
+    // ~Query() will block until all pending tiles have been processed,
+    // so let other threads run in the meantime
+    Py_BEGIN_ALLOW_THREADS
     self->query.~Query();           // call destructor explicitly
+    Py_END_ALLOW_THREADS
+    self->storeState->removeBuffered(self->resultCount());
+    self->batch.~vector();
+    Py_DECREF(self->target);
+        // Release the target (and hence the FeatureStore) only after
+        // the Query is gone
     Py_TYPE(self)->tp_free(self);
 }
 
@@ -56,10 +74,60 @@ PyObject* PyQuery::iter(PyQuery* self)
     return self;
 }
 
+/**
+ * Returns the number of results in the current batch (not counting
+ * the null pointer that marks the end of the query)
+ */
+size_t PyQuery::resultCount() const
+{
+    size_t count = batch.size();
+    if (count > 0 && batch[count - 1].isNull()) count--;
+    return count;
+}
+
+FeaturePtr PyQuery::nextFeature()
+{
+    if (batchPos == batch.size())
+    {
+        // Another thread may call us while we wait for the query with
+        // the GIL released; the Query must not be used concurrently,
+        // and the batch must not change under the other thread's feet
+        if (busy)
+        {
+            PyErr_SetString(PyExc_ValueError,
+                "Query is already being advanced by another thread");
+            return FeaturePtr();
+        }
+        size_t maxBatchSize = std::min(MAX_BATCH_SIZE, target->bufferedResultLimit());
+        size_t batchSize = std::min(std::max(batch.size() * 2, size_t(1)), maxBatchSize);
+        std::vector<FeaturePtr> fetched;
+        fetched.reserve(batchSize);
+        busy = true;
+        Py_BEGIN_ALLOW_THREADS
+        while (fetched.size() < batchSize)
+        {
+            FeaturePtr feature = query.next();
+            fetched.push_back(feature);
+            if (feature.isNull()) break;
+        }
+        Py_END_ALLOW_THREADS
+        busy = false;
+        storeState->removeBuffered(resultCount());
+        batch.swap(fetched);
+        batchPos = 0;
+        storeState->addBuffered(resultCount());
+    }
+    FeaturePtr feature = batch[batchPos];
+    if (!feature.isNull()) batchPos++;
+        // Once the query is exhausted, we keep returning the null pointer
+        // at the end of the batch
+    return feature;
+}
+
 PyObject* PyQuery::next(PyQuery* self)
 {
     // LOG("PyQuery::next()");
-    FeaturePtr pFeature = self->query.next();
+    FeaturePtr pFeature = self->nextFeature();
     if (!pFeature.isNull())
     {
         return PyFeature::create(self->query.store(), pFeature, Py_None);
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <vector>
 #include <geodesk/query/Query.h>
 
 
@@ -19,15 +20,22 @@
 
 using namespace geodesk;
 class PyFeatures;
+class StoreState;
 
 class PyQuery : public PyObject
 {
 public:
     PyFeatures* target;
     Query query;
+    std::vector<FeaturePtr> batch;
+    size_t batchPos;
+    bool busy;              // a thread is fetching the next batch
+    StoreState* storeState;
 
     static PyTypeObject TYPE;
 
+    static const size_t MAX_BATCH_SIZE = 512;
+
     static PyQuery* create(PyFeatures* features);
     static PyQuery* create(PyFeatures* features,
         const Box& box, FeatureTypes types,
@@ -35,5 +43,23 @@ public:
     static void dealloc(PyQuery* self);
     static PyObject* iter(PyQuery* self);
     static PyObject* next(PyQuery* self);
+
+    /**
+     * Returns the next feature, or a null pointer if there are no
+     * more results (or if another thread is fetching results from
+     * the same query, in which case a ValueError is raised; callers
+     * must check PyErr_Occurred()). The results are fetched with the
+     * GIL released, 
+     * in batches (which start with a single feature and grow up to 
+     * MAX_BATCH_SIZE, or the selection's `max_buffered_results` if lower),
+     * so other Python threads can run while this 
+     * thread waits for the query engine, without paying the cost
+     * of a GIL handoff for every feature.
+     */
+    FeaturePtr nextFeature();
+
+private:
+    void init(PyFeatures* features);
+    size_t resultCount() const;
 };
 
@@ -2,10 +2,15 @@
 // SPDX-License-Identifier: LGPL-3.0-only
 
 #include "PyTile.h"
+#include <bit>
+#include <geodesk/geom/GeometryBuilder.h>
+#include "python/Environment.h"
 #include "python/geom/PyBox.h"
 
 #include "PyTile_lookup.cxx"
 #include "python/feature/PyFeature.h"
+#include "PyFeatures.h"
+#include "StoreState.h"
 
 PyTile* PyTile::create(FeatureStore* store, Tile tile, Tip tip)
 {
@@ -22,7 +27,7 @@ PyTile* PyTile::create(FeatureStore* store, Tile tile, Tip tip)
 
 void PyTile::dealloc(PyTile* self)
 {
-	self->store->release();
+	StoreState::release(self->store);
 	Py_TYPE(self)->tp_free(self);
 }
 
@@ -76,11 +81,11 @@ PyObject* PyTile::richcompare(PyTile* self, PyObject* other, int op)
 		switch (op)
 		{
 		case Py_EQ:
-			res = (self->store == tile->store && self->tip == tile->tip) ?
+			res = (self->store == tile->store && self->tip_ == tile->tip_) ?
 				Py_True : Py_False;
 			break;
 		case Py_NE:
-			res = (self->store != tile->store || self->tip != tile->tip) ?
+			res = (self->store != tile->store || self->tip_ != tile->tip_) ?
 				Py_True : Py_False;
 			break;
 		default:
@@ -118,9 +123,70 @@ PyObject* PyTile::bounds(PyTile* self)
 	return PyBox::create(self->tile_.bounds());
 }
 
+/**
+ * Calls `fn(tile, tip)` for each tile of the tile index that contains
+ * the given point. Since `xy` never lies on the edge of a tile, the 
+ * walker only visits one tile per zoom level (instead of all the tiles
+ * in an area).
+ */
+template<typename Fn>
+static void walkPath(FeatureStore* store, Coordinate xy, Fn fn)
+{
+	TileIndexWalker tiw(store->tileIndex(), store->zoomLevels(), Box(xy), nullptr);
+	do
+	{
+		fn(tiw.currentTile(), tiw.currentTip());
+	}
+	while (tiw.next());
+}
+
+/**
+ * Returns a point inside the given tile (one pixel away from its
+ * corner, so it doesn't touch any neighboring tiles).
+ */
+static Coordinate insidePoint(Tile tile)
+{
+	Box bounds = tile.bounds();
+	return Coordinate(bounds.minX() + 1, bounds.minY() + 1);
+}
+
 PyObject* PyTile::children(PyTile* self)
 {
-	Py_RETURN_NONE;	// TODO
+	// The children are the tiles on the next zoom level of the pyramid
+	// (which may skip zoom levels); rather than walking all descendants,
+	// we follow the path to each cell of that level within our tile
+	PyObject* list = PyList_New(0);
+	if (!list) return NULL;
+	Tile ownTile = self->tile_;
+	uint32_t levels = self->store->zoomLevels();
+	uint32_t below = levels & ~((2u << ownTile.zoom()) - 1);
+	if (!below) return list;	// lowest level
+	int childZoom = std::countr_zero(below);
+	int step = childZoom - ownTile.zoom();
+	int extent = 1 << step;
+	for (int row = 0; row < extent; row++)
+	{
+		for (int col = 0; col < extent; col++)
+		{
+			Tile cell = Tile::fromColumnRowZoom((ownTile.column() << step) + col,
+				(ownTile.row() << step) + row, childZoom);
+			Tip childTip;
+			walkPath(self->store, insidePoint(cell), [&](Tile tile, Tip tip)
+				{
+					if (tile == cell) childTip = tip;
+				});
+			if (childTip.isNull()) continue;
+			PyObject* child = PyTile::create(self->store, cell, childTip);
+			if (!child || PyList_Append(list, child) < 0)
+			{
+				Py_XDECREF(child);
+				Py_DECREF(list);
+				return NULL;
+			}
+			Py_DECREF(child);
+		}
+	}
+	return list;
 }
 
 PyObject* PyTile::column(PyTile* self)
@@ -168,12 +234,16 @@ PyObject* PyTile::exports(PyTile* self)
 
 PyObject* PyTile::features(PyTile* self)
 {
-	Py_RETURN_NONE;	// TODO
+	PyFeatures* world = PyFeatures::createWorld(self->store);
+	if (!world) return NULL;
+	PyFeatures* features = world->withTile(self->tile_, self->tip_);
+	Py_DECREF(world);
+	return features;
 }
 
 PyObject* PyTile::id(PyTile* self)
 {
-	Py_RETURN_NONE;
+	return str(self);
 }
 
 PyObject* PyTile::indexes(PyTile* self)
@@ -194,13 +264,26 @@ PyObject* PyTile::is_current(PyTile* self)
 
 PyObject* PyTile::is_loaded(PyTile* self)
 {
-	Py_RETURN_NONE; // TODO
+	TilePtr pTile = self->store->fetchTile(self->tip_);
+	return Python::boolValue(static_cast<bool>(pTile));
 }
 
 
 PyObject* PyTile::parent(PyTile* self)
 {
-	Py_RETURN_NONE; // TODO
+	Tile ownTile = self->tile_;
+	uint32_t levels = self->store->zoomLevels();
+	uint32_t above = levels & ((1u << ownTile.zoom()) - 1);
+	if (!above) Py_RETURN_NONE;		// root tile
+	int parentZoom = 31 - std::countl_zero(above);
+	Tile parentTile = ownTile.zoomedOut(parentZoom);
+	Tip parentTip;
+	walkPath(self->store, insidePoint(ownTile), [&](Tile tile, Tip tip)
+		{
+			if (tile == parentTile) parentTip = tip;
+		});
+	if (parentTip.isNull()) Py_RETURN_NONE;
+	return PyTile::create(self->store, parentTile, parentTip);
 }
 
 PyObject* PyTile::revision(PyTile* self)
@@ -221,8 +304,11 @@ PyObject* PyTile::row(PyTile* self)
 
 PyObject* PyTile::shape(PyTile* self)
 {
-	// TODO
-	Py_RETURN_NONE;
+	Environment& env = Environment::get();
+	GEOSContextHandle_t geosContext = env.getGeosContext();
+	if (!geosContext) return NULL;
+	GEOSGeometry* geom = GeometryBuilder::buildBoxGeometry(self->tile_.bounds(), geosContext);
+	return env.buildShapelyGeometry(geom);
 }
 
 PyObject* PyTile::size(PyTile* self)
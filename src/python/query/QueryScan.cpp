@@ -0,0 +1,219 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "QueryScan.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+#include <geodesk/query/Query.h>
+#include "python/util/WorkPool.h"
+#include "PyFeatures.h"
+#include "StoreState.h"
+
+/// State shared between the calling thread and the workers. Workers
+/// may start after the scan has finished (if the pool is busy with
+/// other work), hence they hold on to it via shared_ptr
+struct QueryScan::State
+{
+    std::mutex mutex;
+    std::condition_variable workerDone;
+    std::deque<std::vector<FeaturePtr>> batches;
+    size_t maxBatches = 0;      // bounded by the selection's max_buffered_results
+    StoreState* storeState = nullptr;
+    const Processor* process = nullptr;
+    std::vector<int> freeSlots;
+    int scheduledWorkers = 0;   // posted to the pool, but not yet returned
+    int activeWorkers = 0;      // started, but not yet returned
+    bool closed = false;        // workers must not start anymore
+    bool failed = false;
+    bool outOfMemory = false;
+    std::string error;
+
+    // Must hold the mutex
+    void push(std::vector<FeaturePtr>&& batch)
+    {
+        storeState->addBuffered(batch.size());
+        batches.push_back(std::move(batch));
+    }
+
+    // Must hold the mutex
+    std::vector<FeaturePtr> pop()
+    {
+        std::vector<FeaturePtr> batch = std::move(batches.front());
+        batches.pop_front();
+        storeState->removeBuffered(batch.size());
+        return batch;
+    }
+
+    // Must not hold the mutex
+    void fail(const char* message)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (failed) return;
+        failed = true;
+        if (message)
+        {
+            error = message;
+        }
+        else
+        {
+            outOfMemory = true;
+        }
+    }
+
+    bool call(int slot, const std::vector<FeaturePtr>& batch)
+    {
+        try
+        {
+            (*process)(slot, batch.data(), batch.size());
+            return true;
+        }
+        catch (const std::bad_alloc&)
+        {
+            fail(nullptr);
+        }
+        catch (const std::exception& ex)
+        {
+            fail(ex.what());
+        }
+        return false;
+    }
+};
+
+QueryScan::QueryScan(PyFeatures* features) :
+    features_(features),
+    storeState_(StoreState::of(features->store)),
+    pool_(WorkPool::get())
+{
+    workerCount_ = storeState_->acquireWorkers(pool_->threadCount(), features->threads);
+}
+
+QueryScan::~QueryScan()
+{
+    storeState_->releaseWorkers(workerCount_);
+}
+
+// Pool tasks must not block, so a worker only processes the batches
+// that are already queued, and returns once the queue is empty; the
+// calling thread posts a new task whenever it queues a batch while
+// fewer than workerCount_ tasks are scheduled
+void QueryScan::work(std::shared_ptr<State> state)
+{
+    std::unique_lock<std::mutex> lock(state->mutex);
+    if (!state->closed)
+    {
+        state->activeWorkers++;
+        int slot = state->freeSlots.back();
+        state->freeSlots.pop_back();
+        while (!state->batches.empty() && !state->failed)
+        {
+            std::vector<FeaturePtr> batch = state->pop();
+            lock.unlock();
+            state->call(slot, batch);
+            lock.lock();
+        }
+        state->freeSlots.push_back(slot);
+        state->activeWorkers--;
+    }
+    state->scheduledWorkers--;
+    state->workerDone.notify_all();
+}
+
+bool QueryScan::run(const Processor& process)
+{
+    std::shared_ptr<State> state = std::make_shared<State>();
+    state->process = &process;
+    state->storeState = storeState_;
+    for (int i = workerCount_; i > 0; i--) state->freeSlots.push_back(i);
+    state->maxBatches = std::min((size_t)workerCount_ * 2,
+        std::max(features_->bufferedResultLimit() / BATCH_SIZE, size_t(1)));
+    Py_BEGIN_ALLOW_THREADS
+    scan(state);
+    Py_END_ALLOW_THREADS
+
+    if (state->failed)
+    {
+        if (state->outOfMemory)
+        {
+            PyErr_NoMemory();
+        }
+        else
+        {
+            PyErr_SetString(PyExc_RuntimeError, state->error.c_str());
+        }
+        return false;
+    }
+    return true;
+}
+
+void QueryScan::scan(const std::shared_ptr<State>& state)
+{
+    try
+    {
+        produce(state);
+    }
+    catch (const std::bad_alloc&)
+    {
+        state->fail(nullptr);
+    }
+    catch (const std::exception& ex)
+    {
+        state->fail(ex.what());
+    }
+
+    // Help the workers with any remaining batches (or, if the scan
+    // failed, discard them, so their results no longer count as
+    // buffered), then wait for the workers that have started
+    std::unique_lock<std::mutex> lock(state->mutex);
+    while (!state->batches.empty())
+    {
+        std::vector<FeaturePtr> remaining = state->pop();
+        if (state->failed) continue;
+        lock.unlock();
+        state->call(0, remaining);
+        lock.lock();
+    }
+    state->closed = true;
+    state->workerDone.wait(lock, [&state] { return state->activeWorkers == 0; });
+}
+
+void QueryScan::produce(const std::shared_ptr<State>& state)
+{
+    Query query(features_->store, features_->bounds, features_->acceptedTypes,
+        features_->matcher, features_->filter);
+    std::vector<FeaturePtr> batch;
+    batch.reserve(BATCH_SIZE);
+    for (;;)
+    {
+        FeaturePtr feature = query.next();
+        if (!feature.isNull()) batch.push_back(feature);
+        if (batch.size() == BATCH_SIZE || (feature.isNull() && !batch.empty()))
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            if (state->failed) return;
+            if (state->batches.size() < state->maxBatches)
+            {
+                state->push(std::move(batch));
+                bool schedule = state->scheduledWorkers < workerCount_;
+                if (schedule) state->scheduledWorkers++;
+                lock.unlock();
+                if (schedule) pool_->post([state]() { work(state); });
+                batch = std::vector<FeaturePtr>();
+                batch.reserve(BATCH_SIZE);
+            }
+            else
+            {
+                // The workers are busy (or there aren't any), so we
+                // process this batch ourselves
+                lock.unlock();
+                if (!state->call(0, batch)) return;
+                batch.clear();
+            }
+        }
+        if (feature.isNull()) return;
+    }
+}
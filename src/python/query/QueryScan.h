@@ -0,0 +1,64 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#pragma once
+
+#include <Python.h>
+#include <functional>
+#include <memory>
+#include <geodesk/feature/FeaturePtr.h>
+
+using namespace geodesk;
+class PyFeatures;
+class StoreState;
+class WorkPool;
+
+/// \brief Runs the query of a World selection and processes its results
+/// in parallel, using the calling thread and workers of the shared
+/// WorkPool (up to the limit set via `Features(..., threads=N)`).
+///
+/// The calling thread runs the query (with the GIL released) and hands
+/// the results to the workers in batches. Workers never wait for
+/// batches; they return to the pool once the queue is empty, and the
+/// calling thread posts new ones as more batches arrive. Each thread
+/// that takes part has a slot number that no other thread uses at the
+/// same time (the calling thread uses slot 0), so callers can keep
+/// partial results per slot without locking, and combine them once
+/// run() returns.
+///
+/// The query itself is executed by libgeodesk, whose own threads aren't
+/// part of the WorkPool (nor subject to the `threads` limit).
+///
+/// The Processor must not call into Python.
+///
+class QueryScan
+{
+public:
+    using Processor = std::function<void(int slot,
+        const FeaturePtr* features, size_t count)>;
+
+    explicit QueryScan(PyFeatures* features);
+    ~QueryScan();
+
+    /// Number of threads (and hence slots) that may take part
+    int slotCount() const { return workerCount_ + 1; }
+
+    /// Runs the query and calls `process` for each batch of results.
+    /// Must be called with the GIL held. Returns false (with a Python
+    /// exception set) if processing failed.
+    bool run(const Processor& process);
+
+    static const size_t BATCH_SIZE = 256;
+
+private:
+    struct State;
+
+    void scan(const std::shared_ptr<State>& state);
+    void produce(const std::shared_ptr<State>& state);
+    static void work(std::shared_ptr<State> state);
+
+    PyFeatures* features_;
+    StoreState* storeState_;
+    std::shared_ptr<WorkPool> pool_;
+    int workerCount_;
+};
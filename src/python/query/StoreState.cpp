@@ -0,0 +1,145 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "StoreState.h"
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <geodesk/feature/FeatureStore.h>
+#include <vector>
+#include "python/feature/StringObjectCache.h"
+#include "python/geom/GeometryCache.h"
+
+static std::mutex STATES_MUTEX;
+static std::unordered_map<FeatureStore*, std::unique_ptr<StoreState>> STATES;
+
+StoreState* StoreState::of(FeatureStore* store)
+{
+    std::lock_guard<std::mutex> lock(STATES_MUTEX);
+    std::unique_ptr<StoreState>& state = STATES[store];
+    if (!state) state.reset(new StoreState(store));
+    return state.get();
+}
+
+void StoreState::release(FeatureStore* store)
+{
+    if (store->refcount() == 1)
+    {
+        // The store closes along with this reference, so it can't be
+        // used by any other thread
+        std::unique_ptr<StoreState> state;
+        {
+            std::lock_guard<std::mutex> lock(STATES_MUTEX);
+            auto it = STATES.find(store);
+            if (it != STATES.end())
+            {
+                state = std::move(it->second);
+                STATES.erase(it);
+            }
+        }
+        // Release the cached objects outside of the lock
+        if (state) state->clear();
+    }
+    store->release();
+}
+
+void StoreState::clearCaches()
+{
+    std::vector<StoreState*> states;
+    {
+        std::lock_guard<std::mutex> lock(STATES_MUTEX);
+        for (const auto& [store, state] : STATES) states.push_back(state.get());
+    }
+    for (StoreState* state : states) state->clear();
+}
+
+void StoreState::clear()
+{
+    strings_->clear();
+    geometries_->clear();
+}
+
+StoreState::StoreState(FeatureStore* store) :
+    activeWorkers_(0),
+    bufferedResults_(0),
+    peakBufferedResults_(0),
+    producerWaits_(0),
+    geometries_(new GeometryCache()),
+    // The cache doesn't touch Python objects until it is used
+    strings_(new StringObjectCache(store))
+{
+    const std::string& fileName = store->fileName();
+    std::error_code error;
+    std::filesystem::path path = std::filesystem::absolute(fileName, error);
+    absolutePath_ = error ? fileName : path.string();
+}
+
+StoreState::~StoreState()
+{
+    // States of stores that are still open when the process exits are
+    // destroyed after the interpreter has been finalized and the
+    // thread-local GEOS contexts have been destroyed; clearCaches() has
+    // normally released the cached objects by then. ~StringObjectCache
+    // leaves any string objects alone, and we abandon any remaining
+    // geometries, since they can't be destroyed without a context.
+    if (!geometries_->isEmpty()) geometries_.release();
+}
+
+void StoreState::addBuffered(size_t count)
+{
+    size_t buffered = bufferedResults_.fetch_add(count, std::memory_order_relaxed) + count;
+    size_t peak = peakBufferedResults_.load(std::memory_order_relaxed);
+    while (buffered > peak &&
+        !peakBufferedResults_.compare_exchange_weak(peak, buffered, std::memory_order_relaxed))
+    {
+    }
+}
+
+PyObject* StoreState::stats(size_t maxBufferedResults) const
+{
+    return Py_BuildValue("{s:n,s:n,s:n,s:K}",
+        "buffered_results", (Py_ssize_t)bufferedResults_.load(),
+        "peak_buffered_results", (Py_ssize_t)peakBufferedResults_.load(),
+        "max_buffered_results", (Py_ssize_t)maxBufferedResults,
+        "producer_waits", (unsigned long long)producerWaits_.load());
+}
+
+bool StoreState::findTile(const uint8_t* p, Tip& tip, uint32_t& offset) const
+{
+    std::lock_guard<std::mutex> lock(tilesMutex_);
+    auto it = tiles_.upper_bound(p);
+    if (it == tiles_.begin()) return false;
+    --it;
+    size_t ofs = static_cast<size_t>(p - it->first);
+    if (ofs >= it->second.size) return false;
+    tip = it->second.tip;
+    offset = static_cast<uint32_t>(ofs);
+    return true;
+}
+
+void StoreState::addTile(Tip tip, const uint8_t* start, uint32_t size)
+{
+    std::lock_guard<std::mutex> lock(tilesMutex_);
+    tiles_[start] = { tip, size };
+}
+
+int StoreState::acquireWorkers(int wanted, int limit)
+{
+    if (limit == 0)
+    {
+        activeWorkers_ += wanted;
+        return wanted;
+    }
+    int active = activeWorkers_.load();
+    for (;;)
+    {
+        // The calling thread counts towards the limit
+        int granted = std::max(std::min(wanted, limit - 1 - active), 0);
+        if (activeWorkers_.compare_exchange_weak(active, active + granted))
+        {
+            return granted;
+        }
+    }
+}
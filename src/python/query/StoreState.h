@@ -0,0 +1,111 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#pragma once
+
+#include <Python.h>
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <geodesk/feature/Tip.h>
+
+namespace geodesk {
+class FeatureStore;
+}
+using namespace geodesk;
+class GeometryCache;
+class StringObjectCache;
+
+/// \brief Caches and bookkeeping that the bindings keep for each
+/// open FeatureStore (the store itself belongs to libgeodesk).
+///
+/// A state is created when the bindings first need it, and lives as
+/// long as the store: the bindings release their references to stores
+/// via StoreState::release(), which frees the state (and the objects
+/// it caches) along with the last reference.
+///
+class StoreState
+{
+public:
+    ~StoreState();
+
+    /// Returns the state of the given store (never null); requires
+    /// the GIL
+    static StoreState* of(FeatureStore* store);
+
+    /// Releases a reference to the store; if it is the last one, the
+    /// store's state is freed as well. Requires the GIL
+    static void release(FeatureStore* store);
+
+    /// Releases the Python objects and GEOS geometries cached for all
+    /// stores (called when the last instance of the module is freed)
+    static void clearCaches();
+
+    /// The absolute path of the store's file (used for pickling, since
+    /// the receiving process may have a different working directory)
+    const std::string& absolutePath() const { return absolutePath_; }
+
+    /// Reserves up to `wanted` pool workers for a job, taking into
+    /// account the workers used by other jobs of the store. `limit`
+    /// is the maximum number of threads (including the calling thread)
+    /// that may process the store's results at the same time (as set
+    /// via `Features(..., threads=N)`), or 0 if only limited by the
+    /// size of the WorkPool. Returns the number of workers reserved
+    /// (may be 0, in which case the calling thread does all the work)
+    int acquireWorkers(int wanted, int limit);
+    void releaseWorkers(int count) { activeWorkers_ -= count; }
+
+    /// Tracks results that have been fetched from the query engine,
+    /// but not yet handed to Python (across all queries of the store);
+    /// results still queued inside the engine aren't counted
+    void addBuffered(size_t count);
+    void removeBuffered(size_t count)
+    {
+        bufferedResults_.fetch_sub(count, std::memory_order_relaxed);
+    }
+
+    /// Records that a query paused because its consumer fell behind
+    void countWait() { producerWaits_.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Returns the statistics of the bindings' result buffers as a dict,
+    /// including the given per-query limit
+    PyObject* stats(size_t maxBufferedResults) const;
+
+    /// The cache of GEOS geometries built for the store's features
+    GeometryCache& geometries() const { return *geometries_; }
+
+    /// The string objects of the store's global strings
+    StringObjectCache& strings() const { return *strings_; }
+
+    /// Finds the tile that contains the given address (among the tiles
+    /// that have been recorded via addTile()); returns false if none
+    bool findTile(const uint8_t* p, Tip& tip, uint32_t& offset) const;
+
+    /// Records the location of a tile, so findTile() can find the tiles
+    /// of pickled features without walking the tile index
+    void addTile(Tip tip, const uint8_t* start, uint32_t size);
+
+private:
+    explicit StoreState(FeatureStore* store);
+    void clear();
+
+    std::string absolutePath_;
+    std::atomic<int> activeWorkers_;
+    std::atomic<size_t> bufferedResults_;
+    std::atomic<size_t> peakBufferedResults_;
+    std::atomic<uint64_t> producerWaits_;
+    std::unique_ptr<GeometryCache> geometries_;
+    std::unique_ptr<StringObjectCache> strings_;
+
+    struct TileLocation
+    {
+        Tip tip;
+        uint32_t size;
+    };
+    /// Tiles by their start address
+    std::map<const uint8_t*, TileLocation> tiles_;
+    mutable std::mutex tilesMutex_;
+};
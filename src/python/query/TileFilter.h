@@ -0,0 +1,85 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#pragma once
+
+#include <geodesk/feature/FeatureStore.h>
+#include <geodesk/filter/Filter.h>
+
+using namespace geodesk;
+
+/// \brief Accepts only the features stored in a specific tile, and of
+/// those only the ones that the tile "owns" with respect to the bounding
+/// box of the selection.
+///
+/// A feature whose bounding box spans several tiles is stored in each
+/// of them; its copies carry the MULTITILE_WEST and MULTITILE_NORTH flags
+/// if the feature is also stored in the tile to the west or north.
+/// A query returns only the copy in the westernmost/northernmost tile that
+/// lies within its bounding box, and we apply the same rule against the
+/// bounds of the original selection. Since a tile-restricted query only
+/// searches the tile's own area, this ensures that every feature of the
+/// selection is returned by exactly one of its tiles.
+///
+/// If `bounds` are the tile's own bounds, the filter accepts every
+/// feature stored in the tile (including the copies of multi-tile
+/// features that other tiles own).
+///
+class TileFilter : public Filter
+{
+public:
+    TileFilter(FeatureStore* store, Tile tile, Tip tip, const Box& bounds) :
+        tile_(tile),
+        tileBounds_(tile.bounds()),
+        selectionBounds_(bounds),
+        start_(nullptr),
+        end_(nullptr)
+    {
+        flags_ = FilterFlags::FAST_TILE_FILTER;
+        acceptedTypes_ = FeatureTypes::ALL;
+        TilePtr pTile = store->fetchTile(tip);
+        if (pTile)
+        {
+            start_ = pTile.ptr().ptr();
+            end_ = start_ + pTile.totalSize();
+        }
+    }
+
+    int acceptTile(Tile tile) const override
+    {
+        if (tile == tile_) return 0;
+        // The ancestors of our tile must not be skipped, in case the
+        // tile walker doesn't descend into the children of a rejected
+        // tile (their features are rejected by accept() instead)
+        if (tile.zoom() < tile_.zoom() && tile_.zoomedOut(tile.zoom()) == tile)
+        {
+            return 0;
+        }
+        return -1;
+    }
+
+    bool accept(FeatureStore* store, FeaturePtr feature, FastFilterHint fast) const override
+    {
+        const uint8_t* p = feature.ptr().ptr();
+        if (p < start_ || p >= end_) return false;
+        int flags = feature.flags();
+        if ((flags & FeatureFlags::MULTITILE_WEST) &&
+            tileBounds_.minX() > selectionBounds_.minX())
+        {
+            return false;
+        }
+        if ((flags & FeatureFlags::MULTITILE_NORTH) &&
+            tileBounds_.maxY() < selectionBounds_.maxY())
+        {
+            return false;
+        }
+        return true;
+    }
+
+private:
+    Tile tile_;
+    Box tileBounds_;
+    Box selectionBounds_;
+    const uint8_t* start_;
+    const uint8_t* end_;
+};
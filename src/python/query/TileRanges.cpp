@@ -0,0 +1,60 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "TileRanges.h"
+#include <mutex>
+#include <geodesk/feature/NodePtr.h>
+#include <geodesk/query/TileIndexWalker.h>
+
+TileRanges::TileRanges(FeatureStore* store, const Box& bounds, const Filter* filter) :
+    store_(store)
+{
+    TileIndexWalker tiw(store->tileIndex(), store->zoomLevels(), bounds, filter);
+    do
+    {
+        indexes_.emplace(tiw.currentTip().value(), tiles_.size());
+        tiles_.emplace_back(tiw.currentTile(), tiw.currentTip());
+    }
+    while (tiw.next());
+}
+
+ptrdiff_t TileRanges::findRange(const uint8_t* p) const
+{
+    auto it = ranges_.upper_bound(p);
+    if (it == ranges_.begin()) return -1;
+    --it;
+    return p < it->second.end ? static_cast<ptrdiff_t>(it->second.index) : -1;
+}
+
+ptrdiff_t TileRanges::tileOf(FeaturePtr feature) const
+{
+    const uint8_t* p = feature.ptr().ptr();
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        ptrdiff_t index = findRange(p);
+        if (index >= 0) return index;
+    }
+
+    // The feature's tile is one of the tiles covered by its bounding box
+    // (a handful per zoom level), so we only need to locate those
+    Box bounds = feature.isNode() ? Box(NodePtr(feature).xy()) : feature.bounds();
+    ptrdiff_t found = -1;
+    std::vector<std::pair<const uint8_t*, Range>> newRanges;
+    TileIndexWalker tiw(store_->tileIndex(), store_->zoomLevels(), bounds, nullptr);
+    do
+    {
+        auto it = indexes_.find(tiw.currentTip().value());
+        if (it == indexes_.end()) continue;
+        TilePtr pTile = store_->fetchTile(tiw.currentTip());
+        if (!pTile) continue;
+        const uint8_t* start = pTile.ptr().ptr();
+        const uint8_t* end = start + pTile.totalSize();
+        newRanges.push_back({ start, { end, it->second } });
+        if (p >= start && p < end) found = static_cast<ptrdiff_t>(it->second);
+    }
+    while (tiw.next());
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    ranges_.insert(newRanges.begin(), newRanges.end());
+    return found;
+}
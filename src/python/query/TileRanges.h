@@ -0,0 +1,59 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#pragma once
+
+#include <map>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+#include <geodesk/feature/FeaturePtr.h>
+#include <geodesk/feature/FeatureStore.h>
+#include <geodesk/feature/Tip.h>
+#include <geodesk/geom/Box.h>
+#include <geodesk/geom/Tile.h>
+
+using namespace geodesk;
+
+/// \brief The tiles of a selection, in the order returned by the tile
+/// index walker (the same order as Features.tiles), with the address
+/// ranges of their data, so the tile of a query result can be found
+/// by its address.
+///
+/// A query returns a feature that spans several tiles only once, from
+/// one of its tiles; tileOf() attributes the feature to that tile (the
+/// same tile that Tile.features assigns it to).
+///
+/// Walking the tile index doesn't touch the tiles themselves; the
+/// address range of a tile is only looked up once tileOf() is asked
+/// for one of its features (at which point the query has loaded it).
+///
+class TileRanges
+{
+public:
+    TileRanges(FeatureStore* store, const Box& bounds, const Filter* filter);
+
+    size_t size() const { return tiles_.size(); }
+    Tile tile(size_t i) const { return tiles_[i].first; }
+    Tip tip(size_t i) const { return tiles_[i].second; }
+
+    /// Returns the tile that holds the given feature, or -1 if it
+    /// doesn't belong to any of the tiles (or the tile isn't loaded)
+    /// Safe to call from any thread.
+    ptrdiff_t tileOf(FeaturePtr feature) const;
+
+private:
+    struct Range
+    {
+        const uint8_t* end;
+        size_t index;
+    };
+
+    ptrdiff_t findRange(const uint8_t* p) const;
+
+    FeatureStore* store_;
+    std::vector<std::pair<Tile,Tip>> tiles_;
+    std::unordered_map<uint32_t,size_t> indexes_;   // tile index by TIP
+    mutable std::map<const uint8_t*, Range> ranges_;     // by start address
+    mutable std::shared_mutex mutex_;
+};
@@ -0,0 +1,208 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "PyNumArray.h"
+#include <cassert>
+#include <cstdint>
+
+static int itemSizeOf(char format)
+{
+    switch (format)
+    {
+    case 'b':
+    case 'B':
+        return 1;
+    case 'i':
+    case 'I':
+        return 4;
+    case 'q':
+    case 'Q':
+    case 'd':
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+PyNumArray* PyNumArray::create(char format, Py_ssize_t count, Py_ssize_t columns)
+{
+    int itemSize = itemSizeOf(format);
+    assert(itemSize != 0);
+    Py_ssize_t total = columns < 0 ? count : count * columns;
+    void* data = PyMem_RawCalloc(total ? total : 1, itemSize);
+    if (!data)
+    {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    PyNumArray* self = (PyNumArray*)TYPE.tp_alloc(&TYPE, 0);
+    if (!self)
+    {
+        PyMem_RawFree(data);
+        return NULL;
+    }
+    self->data = data;
+    self->itemSize = itemSize;
+    self->format[0] = format;
+    self->format[1] = 0;
+    self->shape[0] = count;
+    if (columns < 0)
+    {
+        self->ndim = 1;
+        self->strides[0] = itemSize;
+    }
+    else
+    {
+        self->ndim = 2;
+        self->shape[1] = columns;
+        self->strides[0] = columns * itemSize;
+        self->strides[1] = itemSize;
+    }
+    return self;
+}
+
+void PyNumArray::dealloc(PyNumArray* self)
+{
+    PyMem_RawFree(self->data);
+    Py_TYPE(self)->tp_free(self);
+}
+
+int PyNumArray::getbuffer(PyNumArray* self, Py_buffer* view, int flags)
+{
+    // The array is C-contiguous and never resized, so it can
+    // satisfy any request
+    Py_INCREF(self);
+    view->obj = self;
+    view->buf = self->data;
+    view->len = self->size() * self->itemSize;
+    view->readonly = 0;
+    view->itemsize = self->itemSize;
+    view->format = (flags & PyBUF_FORMAT) ? self->format : NULL;
+    view->ndim = self->ndim;
+    view->shape = (flags & PyBUF_ND) ? self->shape : NULL;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? self->strides : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    return 0;
+}
+
+PyObject* PyNumArray::valueAt(Py_ssize_t index) const
+{
+    switch (format[0])
+    {
+    case 'b':
+        return PyLong_FromLong(values<int8_t>()[index]);
+    case 'B':
+        return PyLong_FromUnsignedLong(values<uint8_t>()[index]);
+    case 'i':
+        return PyLong_FromLong(values<int32_t>()[index]);
+    case 'I':
+        return PyLong_FromUnsignedLong(values<uint32_t>()[index]);
+    case 'q':
+        return PyLong_FromLongLong(values<int64_t>()[index]);
+    case 'Q':
+        return PyLong_FromUnsignedLongLong(values<uint64_t>()[index]);
+    default:
+        return PyFloat_FromDouble(values<double>()[index]);
+    }
+}
+
+Py_ssize_t PyNumArray::len(PyNumArray* self)
+{
+    return self->shape[0];
+}
+
+PyObject* PyNumArray::item(PyNumArray* self, Py_ssize_t index)
+{
+    if (index < 0 || index >= self->shape[0])
+    {
+        PyErr_SetString(PyExc_IndexError, "Index out of range");
+        return NULL;
+    }
+    if (self->ndim == 1) return self->valueAt(index);
+
+    // A row of a 2-D array is returned as a list
+    Py_ssize_t columns = self->shape[1];
+    PyObject* row = PyList_New(columns);
+    if (!row) return NULL;
+    for (Py_ssize_t i = 0; i < columns; i++)
+    {
+        PyObject* value = self->valueAt(index * columns + i);
+        if (!value)
+        {
+            Py_DECREF(row);
+            return NULL;
+        }
+        PyList_SET_ITEM(row, i, value);
+    }
+    return row;
+}
+
+PyObject* PyNumArray::repr(PyNumArray* self)
+{
+    if (self->ndim == 1)
+    {
+        return PyUnicode_FromFormat("<Array '%s' [%zd]>", self->format, self->shape[0]);
+    }
+    return PyUnicode_FromFormat("<Array '%s' [%zd x %zd]>",
+        self->format, self->shape[0], self->shape[1]);
+}
+
+PyObject* PyNumArray::tolist(PyNumArray* self, PyObject* unused)
+{
+    PyObject* view = PyMemoryView_FromObject(self);
+    if (!view) return NULL;
+    PyObject* list = PyObject_CallMethod(view, "tolist", NULL);
+    Py_DECREF(view);
+    return list;
+}
+
+PyObject* PyNumArray::getShape(PyNumArray* self, void* closure)
+{
+    if (self->ndim == 1) return Py_BuildValue("(n)", self->shape[0]);
+    return Py_BuildValue("(nn)", self->shape[0], self->shape[1]);
+}
+
+PyObject* PyNumArray::getFormat(PyNumArray* self, void* closure)
+{
+    return PyUnicode_FromString(self->format);
+}
+
+PyBufferProcs PyNumArray::BUFFER_PROCS =
+{
+    .bf_getbuffer = (getbufferproc)getbuffer,
+    .bf_releasebuffer = NULL,
+};
+
+PySequenceMethods PyNumArray::SEQUENCE_METHODS =
+{
+    .sq_length = (lenfunc)len,
+    .sq_item = (ssizeargfunc)item,
+};
+
+PyMethodDef PyNumArray::METHODS[] =
+{
+    { "tolist", (PyCFunction)tolist, METH_NOARGS, "Returns the values as a (nested) list" },
+    { NULL, NULL, 0, NULL },
+};
+
+PyGetSetDef PyNumArray::GETSET[] =
+{
+    { "shape", (getter)getShape, NULL, "Number of items along each dimension", NULL },
+    { "format", (getter)getFormat, NULL, "Type of the items (as used by the struct module)", NULL },
+    { NULL },
+};
+
+PyTypeObject PyNumArray::TYPE =
+{
+    .tp_name = "geodesk.Array",
+    .tp_basicsize = sizeof(PyNumArray),
+    .tp_dealloc = (destructor)dealloc,
+    .tp_repr = (reprfunc)repr,
+    .tp_as_sequence = &SEQUENCE_METHODS,
+    .tp_as_buffer = &BUFFER_PROCS,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_DISALLOW_INSTANTIATION,
+    .tp_doc = "Array of numbers (supports the buffer protocol)",
+    .tp_methods = METHODS,
+    .tp_getset = GETSET,
+};
@@ -0,0 +1,55 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#pragma once
+
+#include <Python.h>
+
+/// \brief A fixed-size, zero-initialized array of numbers (one- or
+/// two-dimensional), which exposes its contents via the buffer protocol.
+///
+/// Used for results that are computed natively and are typically
+/// consumed by NumPy or pandas (`numpy.asarray(a)` doesn't copy),
+/// such as per-tile statistics and density grids. The array can also
+/// be indexed like a sequence, or turned into a list via tolist().
+///
+/// The contents are filled in by C++ code (which may run without the
+/// GIL, since the buffer isn't visible to Python until it is returned).
+///
+class PyNumArray : public PyObject
+{
+public:
+    void* data;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+    int ndim;
+    int itemSize;
+    char format[2];     // format code, as used by the struct module
+
+    static PyTypeObject TYPE;
+    static PyBufferProcs BUFFER_PROCS;
+    static PySequenceMethods SEQUENCE_METHODS;
+    static PyMethodDef METHODS[];
+    static PyGetSetDef GETSET[];
+
+    /// Creates a 1-D array of `count` items of the given type ('b', 'B',
+    /// 'i', 'I', 'q', 'Q' or 'd'), or a 2-D array of `count` rows with
+    /// `columns` items each
+    static PyNumArray* create(char format, Py_ssize_t count, Py_ssize_t columns = -1);
+
+    template <typename T>
+    T* values() const { return reinterpret_cast<T*>(data); }
+    Py_ssize_t size() const { return ndim == 1 ? shape[0] : shape[0] * shape[1]; }
+
+    static void dealloc(PyNumArray* self);
+    static int getbuffer(PyNumArray* self, Py_buffer* view, int flags);
+    static Py_ssize_t len(PyNumArray* self);
+    static PyObject* item(PyNumArray* self, Py_ssize_t index);
+    static PyObject* repr(PyNumArray* self);
+    static PyObject* tolist(PyNumArray* self, PyObject* unused);
+    static PyObject* getShape(PyNumArray* self, void* closure);
+    static PyObject* getFormat(PyNumArray* self, void* closure);
+
+private:
+    PyObject* valueAt(Py_ssize_t index) const;
+};
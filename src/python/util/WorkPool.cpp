@@ -0,0 +1,220 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#include "WorkPool.h"
+#include <algorithm>
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+std::mutex WorkPool::poolMutex_;
+std::shared_ptr<WorkPool> WorkPool::pool_;
+thread_local int WorkPool::workerIndex_ = -1;
+thread_local WorkPool* WorkPool::workerPool_ = nullptr;
+
+WorkPool::WorkPool(int threadCount, std::vector<int> cpus) :
+    cpus_(std::move(cpus)),
+    queued_(0),
+    nextWorker_(0),
+    startedCount_(0),
+    idleCount_(0),
+    shutdown_(false)
+{
+    if (threadCount <= 0)
+    {
+        // The thread that submits a job works on it as well
+        threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    }
+    // All deques exist up front, since workers steal from each other;
+    // the threads are started by post() as they are needed
+    workers_.reserve(threadCount);
+    for (int i = 0; i < threadCount; i++)
+    {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+}
+
+WorkPool::~WorkPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(idleMutex_);
+        shutdown_ = true;
+    }
+    wakeUp_.notify_all();
+    for (auto& worker : workers_)
+    {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+}
+
+std::shared_ptr<WorkPool> WorkPool::get()
+{
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    if (!pool_) pool_ = std::make_shared<WorkPool>(0, std::vector<int>());
+    return pool_;
+}
+
+void WorkPool::configure(int threadCount, std::vector<int> cpus)
+{
+    std::shared_ptr<WorkPool> oldPool;
+    {
+        std::lock_guard<std::mutex> lock(poolMutex_);
+        oldPool = std::move(pool_);
+        pool_ = std::make_shared<WorkPool>(threadCount, std::move(cpus));
+    }
+    // If no job is using the old pool, it shuts down here (after its
+    // workers have finished any queued tasks)
+}
+
+void WorkPool::pin(std::thread& thread, int cpu)
+{
+#if defined(_WIN32)
+    SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << cpu);
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+    // Thread affinity isn't supported on this platform (macOS only
+    // offers scheduling hints); the setting is ignored
+    (void)thread;
+    (void)cpu;
+#endif
+}
+
+void WorkPool::post(Task&& task)
+{
+    Worker* worker;
+    if (workerPool_ == this)
+    {
+        worker = workers_[workerIndex_].get();
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->tasks.push_front(std::move(task));
+    }
+    else
+    {
+        worker = workers_[nextWorker_++ % workers_.size()].get();
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->tasks.push_back(std::move(task));
+    }
+    size_t queued = ++queued_;
+    {
+        // Lock to avoid a lost wakeup for a worker that has just
+        // found queued_ to be zero, but isn't waiting yet
+        std::lock_guard<std::mutex> lock(idleMutex_);
+        if (idleCount_ < queued && startedCount_ < workers_.size())
+        {
+            // Not enough idle workers to take the queued tasks
+            start(startedCount_++);
+        }
+    }
+    wakeUp_.notify_one();
+}
+
+void WorkPool::start(size_t index)
+{
+    std::thread& thread = workers_[index]->thread;
+    thread = std::thread(&WorkPool::work, this, (int)index);
+    if (!cpus_.empty()) pin(thread, cpus_[index % cpus_.size()]);
+}
+
+bool WorkPool::take(int index, Task& task)
+{
+    Worker* own = workers_[index].get();
+    {
+        std::lock_guard<std::mutex> lock(own->mutex);
+        if (!own->tasks.empty())
+        {
+            task = std::move(own->tasks.front());
+            own->tasks.pop_front();
+            return true;
+        }
+    }
+    size_t count = workers_.size();
+    for (size_t i = 1; i < count; i++)
+    {
+        Worker* victim = workers_[(index + i) % count].get();
+        std::lock_guard<std::mutex> lock(victim->mutex);
+        if (!victim->tasks.empty())
+        {
+            task = std::move(victim->tasks.back());
+            victim->tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkPool::work(int index)
+{
+    workerIndex_ = index;
+    workerPool_ = this;
+    Task task;
+    for (;;)
+    {
+        if (take(index, task))
+        {
+            queued_--;
+            task();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(idleMutex_);
+        idleCount_++;
+        wakeUp_.wait(lock, [this] { return queued_ > 0 || shutdown_; });
+        idleCount_--;
+        if (shutdown_ && queued_ == 0) break;
+    }
+}
+
+PyObject* WorkPool::set_thread_pool(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* KEYWORDS[] = { "threads", "affinity", nullptr };
+    int threadCount;
+    PyObject* affinity = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "i|O", (char**)KEYWORDS,
+        &threadCount, &affinity))
+    {
+        return NULL;
+    }
+    if (threadCount < 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "threads must not be negative");
+        return NULL;
+    }
+    std::vector<int> cpus;
+    if (affinity != Py_None)
+    {
+        PyObject* iter = PyObject_GetIter(affinity);
+        if (!iter) return NULL;
+        PyObject* item;
+        while ((item = PyIter_Next(iter)))
+        {
+            long cpu = PyLong_AsLong(item);
+            Py_DECREF(item);
+            if (cpu == -1 && PyErr_Occurred()) break;
+            if (cpu < 0 || cpu >= 1024)
+            {
+                PyErr_Format(PyExc_ValueError, "Invalid CPU number: %ld", cpu);
+                break;
+            }
+            cpus.push_back((int)cpu);
+        }
+        Py_DECREF(iter);
+        if (PyErr_Occurred()) return NULL;
+    }
+
+    // Shutting down the old pool waits for its workers, which
+    // never need the GIL
+    Py_BEGIN_ALLOW_THREADS
+    configure(threadCount, std::move(cpus));
+    Py_END_ALLOW_THREADS
+    Py_RETURN_NONE;
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2026 Clarisma / GeoDesk contributors
+// SPDX-License-Identifier: LGPL-3.0-only
+
+#pragma once
+
+#include <Python.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// \brief Process-wide work-stealing thread pool, shared by all open
+/// feature stores, for work that the bindings perform on query results
+/// (such as computing the total area or length of a selection).
+///
+/// Each worker has its own task deque. Tasks submitted by a worker go
+/// to the front of its own deque (so related work stays on the same
+/// core); tasks submitted by other threads are distributed round-robin.
+/// A worker takes tasks from the front of its own deque, and steals
+/// from the back of other workers' deques once its own deque is empty.
+///
+/// Tasks must not call into Python, and must not block waiting for
+/// other tasks.
+///
+/// The pool only runs the bindings' own work; queries are executed by
+/// libgeodesk, which uses its own threads. To avoid adding idle threads
+/// on top of those, workers are only started once tasks are queued
+/// that the running workers can't take, so a pool never has more
+/// threads than its jobs have actually needed at the same time.
+///
+/// The pool is created lazily (by default with one worker less than
+/// the number of hardware threads, since the thread that submits a job
+/// takes part as well). set_thread_pool() replaces it; jobs that are
+/// already running keep the old pool alive (via shared_ptr) until they
+/// are done.
+///
+class WorkPool
+{
+public:
+    using Task = std::function<void()>;
+
+    /// Creates a pool with the given number of workers. If `cpus`
+    /// is not empty, worker i is pinned to CPU `cpus[i % cpus.size()]`
+    WorkPool(int threadCount, std::vector<int> cpus);
+    ~WorkPool();
+
+    /// Returns the current process-wide pool
+    static std::shared_ptr<WorkPool> get();
+
+    /// Replaces the process-wide pool (threadCount <= 0 means one
+    /// worker less than the number of hardware threads)
+    static void configure(int threadCount, std::vector<int> cpus);
+
+    /// The maximum number of workers (not all of them may be running)
+    int threadCount() const { return (int)workers_.size(); }
+    void post(Task&& task);
+
+    /// Python: geodesk.set_thread_pool(threads, affinity=None)
+    static PyObject* set_thread_pool(PyObject* self, PyObject* args, PyObject* kwargs);
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    void start(size_t index);
+    void work(int index);
+    bool take(int index, Task& task);
+    static void pin(std::thread& thread, int cpu);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<int> cpus_;
+    std::mutex idleMutex_;
+    std::condition_variable wakeUp_;
+    std::atomic<size_t> queued_;
+    std::atomic<size_t> nextWorker_;
+    size_t startedCount_;       // guarded by idleMutex_
+    size_t idleCount_;          // guarded by idleMutex_
+    bool shutdown_;
+
+    static std::mutex poolMutex_;
+    static std::shared_ptr<WorkPool> pool_;
+    static thread_local int workerIndex_;   // -1 if not a worker thread
+    static thread_local WorkPool* workerPool_;
+};
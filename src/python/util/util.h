@@ -178,6 +178,66 @@ namespace Python
 
 	PyObject* getCurrentExceptionMessage();
 
+	/**
+	 * Holds the per-object lock of a Python object for the current
+	 * scope, to guard objects with mutable state in free-threaded
+	 * builds. Compiles to nothing if the GIL is enabled (the GIL
+	 * already serializes access).
+	 */
+	class CriticalSection
+	{
+	public:
+		CriticalSection(const CriticalSection&) = delete;
+		CriticalSection& operator=(const CriticalSection&) = delete;
+
+	#ifdef Py_GIL_DISABLED
+		explicit CriticalSection(PyObject* obj) { PyCriticalSection_Begin(&cs_, obj); }
+		~CriticalSection() { PyCriticalSection_End(&cs_); }
+
+	private:
+		PyCriticalSection cs_;
+	#else
+		explicit CriticalSection(PyObject*) {}
+	#endif
+	};
+
+	/**
+	 * A lock for native state that is shared by threads, in free-threaded
+	 * builds. Unlike a std::mutex, a PyMutex detaches the thread state
+	 * while it waits, so it may be held while calling into Python without
+	 * deadlocking a stop-the-world pause. Compiles to nothing if the GIL
+	 * is enabled.
+	 */
+	class Mutex
+	{
+	public:
+	#ifdef Py_GIL_DISABLED
+		void lock() { PyMutex_Lock(&mutex_); }
+		void unlock() { PyMutex_Unlock(&mutex_); }
+
+	private:
+		PyMutex mutex_ = {};
+	#else
+		void lock() {}
+		void unlock() {}
+	#endif
+	};
+
+	/**
+	 * Holds a Python::Mutex for the current scope.
+	 */
+	class MutexLock
+	{
+	public:
+		explicit MutexLock(Mutex& mutex) : mutex_(mutex) { mutex.lock(); }
+		~MutexLock() { mutex_.unlock(); }
+		MutexLock(const MutexLock&) = delete;
+		MutexLock& operator=(const MutexLock&) = delete;
+
+	private:
+		Mutex& mutex_;
+	};
+
 	typedef PyObject* (*Getter)(PyObject*);
 
 	class AttrRef
@@ -36,4 +36,36 @@ def test_empty_tags(features):
                 assert node.str("highway") == ""
                 assert node.num("whatever") == 0
                 assert node.highway is None
-                break
\ No newline at end of file
+                break
+
+
+def test_tag_attributes(monaco):
+    """
+    Accessing tags as attributes must yield the same values as looking
+    them up via `tags` (including keys that are local strings)
+    """
+    for f in monaco("na[name]")[:500]:
+        for k, v in f.tags:
+            # (Skip keys that clash with built-in attributes, like "area")
+            if k.startswith(("name", "addr:", "building", "highway")):
+                assert getattr(f, k) == v
+        assert f.no_such_key is None
+        assert f.no_such_key is f.tags["no_such_key"]
+
+def test_tags_dict_protocol(monaco):
+    for f in monaco("na[name]")[:500]:
+        tags = f.tags
+        items = list(tags)
+        d = tags.to_dict()
+        assert d == dict(items)
+        assert tags.items() == items
+        assert tags.keys() == [k for k, v in items]
+        assert tags.values() == [v for k, v in items]
+        for k, v in items:
+            assert k in tags
+            assert tags.get(k) == v
+            assert tags[k] == v
+        assert "no_such_key" not in tags
+        assert 42 not in tags
+        assert tags.get("no_such_key") is None
+        assert tags.get("no_such_key", "x") == "x"
@@ -0,0 +1,47 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+import pytest
+from geodesk import *
+
+def brute_force(features, geom, k):
+    ranked = sorted(features, key=lambda f: (distance(f, geom),
+        0 if f.is_node else (1 if f.is_way else 2), f.id))
+    return ranked[:k]
+
+def test_nearest_to_point(monaco):
+    c = Coordinate(lon=7.4268, lat=43.7358)
+    streets = monaco("w[highway]")
+    nearest = streets.nearest_to(c, k=10)
+    assert len(nearest) == 10
+    d = [distance(f, c) for f in nearest]
+    assert d == sorted(d)
+    expected = [distance(f, c) for f in brute_force(streets, c, 10)]
+    assert d == pytest.approx(expected)
+    assert streets.nearest_to(c)[0] == nearest[0]
+
+def test_nearest_to_feature(monaco):
+    park = monaco.way(157719659)    # Petite Afrique
+    buildings = monaco("a[building]")
+    nearest = buildings.nearest_to(park, k=5)
+    expected = [distance(f, park) for f in brute_force(buildings, park, 5)]
+    assert [distance(f, park) for f in nearest] == pytest.approx(expected)
+    nearest = buildings.nearest_to(park.shape, k=5)
+    assert [distance(f, park) for f in nearest] == pytest.approx(expected, abs=1e-3)
+
+def test_nearest_to_max_distance(monaco):
+    c = Coordinate(lon=7.4268, lat=43.7358)
+    nodes = monaco("n[amenity]")
+    nearest = nodes.nearest_to(c, k=1000, max_distance=200)
+    assert all(distance(f, c) <= 200 for f in nearest)
+    assert len(nearest) == len([f for f in nodes if distance(f, c) <= 200])
+    feet = nodes.nearest_to(c, k=1000, max_distance=200 / 0.3048, units="feet")
+    assert [f.id for f in feet] == [f.id for f in nearest]
+
+def test_nearest_to_edge_cases(monaco):
+    c = Coordinate(lon=7.4268, lat=43.7358)
+    assert monaco("n[amenity]").nearest_to(c, k=0) == []
+    assert monaco("n[no_such_key]").nearest_to(c, k=5) == []
+    assert len(monaco("n[amenity]").nearest_to(c, k=10**9)) == monaco("n[amenity]").count
+    with pytest.raises(ValueError):
+        monaco("n").nearest_to(c, k=-1)
@@ -0,0 +1,38 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+import array
+import pytest
+from geodesk import *
+
+def test_with_ids(monaco):
+    streets = list(monaco("w[highway]"))[::5]
+    ids = [f.id for f in streets]
+    selected = monaco.ways.with_ids(ids)
+    assert set(selected) == set(streets)
+    assert set(monaco.with_ids(ways=ids)) == set(streets)
+    assert monaco.nodes.with_ids(ways=ids).count == 0
+    assert set(monaco("w[highway=residential]").with_ids(ids)) == \
+        set(f for f in streets if f.highway == "residential")
+
+    # IDs from a buffer (including duplicates)
+    buf = array.array('q', ids + ids)
+    assert set(monaco.ways.with_ids(buf)) == set(streets)
+
+def test_with_ids_by_type(monaco):
+    nodes = list(monaco("n[amenity]"))[:10]
+    relations = list(monaco.relations)[:10]
+    selected = monaco.with_ids(nodes=[f.id for f in nodes],
+        relations=[f.id for f in relations])
+    assert set(selected) == set(nodes) | set(relations)
+
+def test_with_ids_errors(monaco):
+    assert monaco.with_ids([]).count == 0
+    with pytest.raises(TypeError):
+        monaco.with_ids()
+    with pytest.raises(ValueError):
+        monaco.with_ids([1, -2])
+    with pytest.raises(TypeError):
+        monaco.with_ids(["123"])
+    with pytest.raises(TypeError):
+        monaco.with_ids(array.array('d', [1.0]))
@@ -146,4 +146,14 @@ def test_numeric_custom_ids(features):
     features("a[leisure=park]").geojson(limit=20, 
         id = lambda f: f.id * 2 + (0 if f.is_way else 1)).save(
         "c:\\geodesk\\tests\\mumeric_ids.geojson")
-    
\ No newline at end of file
+    
+def test_query_geojson(features):
+    # The features of a query are written directly (without creating
+    # Feature objects); the result must match the per-feature output
+    parks = features("a[leisure=park]")
+    def by_id(items):
+        return sorted(items, key=lambda f: f['id'])
+    collection = json.loads(str(parks.geojson))
+    assert by_id(collection['features']) == by_id(
+        [json.loads(str(park.geojson)) for park in parks])
+    assert len(json.loads(str(parks.geojson(limit=5)))['features']) == min(5, parks.count)
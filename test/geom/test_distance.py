@@ -50,3 +50,31 @@ def test_coordinate_distance_method():
     assert d1 == d2
     assert d1 == d3
 
+
+def test_node_way_distances(monaco):
+    # Points and ways are measured natively; compare against
+    # the distance of their Shapely shapes (measured by GEOS)
+    streets = monaco("w[highway=primary]")
+    for node in monaco("n[amenity]"):
+        for street in streets:
+            d1 = distance(node, street)
+            d2 = distance(node.shape, street.shape)
+            assert d1 == pytest.approx(d2, abs=1e-6)
+
+def test_way_way_distances(monaco):
+    buildings = [b for b in monaco("a[building]") if b.is_way][:20]
+    for b1 in buildings:
+        for b2 in buildings:
+            d1 = distance(b1, b2)
+            d2 = distance(b1.shape, b2.shape)
+            assert d1 == pytest.approx(d2, abs=1e-6)
+            if b1 == b2:
+                assert d1 == 0
+
+def test_distance_inside_area(monaco):
+    for building in list(monaco("a[building]"))[:20]:
+        if not building.is_way:
+            continue
+        assert distance(building, building.centroid) == \
+            pytest.approx(distance(building.shape, building.centroid), abs=1e-6)
+        assert distance(building.bounds, building) == 0
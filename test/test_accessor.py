@@ -0,0 +1,45 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+import pytest
+from geodesk import *
+
+def test_accessor_feature(monaco):
+    name = monaco.accessor("name")
+    levels = monaco.accessor("building:levels", type=int)
+    height = monaco.accessor("building:levels", type=float)
+    is_building = monaco.accessor("building", type=bool)
+    for f in monaco("a[building]")[:200]:
+        assert name(f) == f.str("name")
+        assert levels(f) == int(f.num("building:levels"))
+        assert height(f) == pytest.approx(f.num("building:levels"))
+        assert is_building(f) == (f.building not in ("no", "false", "0"))
+    street = monaco("w[highway][name]").first
+    assert monaco.accessor("no_such_key")(street) == ""
+    assert monaco.accessor("no_such_key", type=int)(street) == 0
+    assert monaco.accessor("no_such_key", type=bool)(street) is False
+    with pytest.raises(TypeError):
+        monaco.accessor("name", type=list)
+    with pytest.raises(TypeError):
+        name("not a feature")
+
+def test_accessor_features(monaco):
+    places = monaco("n[place]")
+    result = monaco.accessor("population", type=int)(places)
+    assert len(result["id"]) == places.count
+    expected = sorted((f.id, int(f.num("population"))) for f in places)
+    assert list(zip(result["id"], result["value"])) == expected
+    assert set(result["type"]) == {0}
+    names = monaco.accessor("name")(places)
+    assert sorted(names["value"]) == sorted(f.str("name") for f in places)
+    empty = monaco.accessor("name", type=float)(monaco("n[no_such_key]").ways)
+    assert len(empty["value"]) == 0
+
+def test_accessor_int_column_matches_feature(monaco):
+    # Columns and single lookups must convert values to int the same way
+    # (integers directly, other numbers by truncating)
+    levels = monaco.accessor("building:levels", type=int)
+    buildings = monaco("a[building:levels]")
+    result = levels(buildings)
+    expected = sorted((f.id, levels(f)) for f in buildings)
+    assert sorted(zip(result["id"], result["value"])) == expected
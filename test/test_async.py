@@ -0,0 +1,88 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+import asyncio
+import subprocess
+import sys
+from geodesk import *
+
+async def collect(features):
+    return [f async for f in features.aiter()]
+
+def test_aiter(monaco):
+    streets = monaco("w[highway]")
+    result = asyncio.run(collect(streets))
+    assert len(result) == streets.count
+    assert set(result) == set(streets)
+
+def test_aiter_related(monaco):
+    street = monaco("w[highway][name]").first
+    nodes = asyncio.run(collect(street.nodes))
+    assert nodes == list(street.nodes)
+
+def test_aiter_break(monaco):
+    async def take(features, n):
+        result = []
+        async for f in features.aiter():
+            result.append(f)
+            if len(result) == n:
+                break
+        return result
+    assert len(asyncio.run(take(monaco, 10))) == 10
+
+def test_acount_afirst(monaco):
+    async def run():
+        return await asyncio.gather(
+            monaco.acount(),
+            monaco("na[amenity=restaurant]").acount(),
+            monaco("na[amenity=restaurant]").afirst(),
+            monaco("na[amenity=no_such_thing]").afirst())
+    count, restaurant_count, first, none = asyncio.run(run())
+    assert count == monaco.count
+    assert restaurant_count == monaco("na[amenity=restaurant]").count
+    assert first in monaco("na[amenity=restaurant]")
+    assert none is None
+
+def test_concurrent_aiter(monaco):
+    queries = ["na[amenity]", "w[highway]", "a[building]", "r"]
+    async def run():
+        return await asyncio.gather(*(collect(monaco(q)) for q in queries))
+    results = asyncio.run(run())
+    for q, result in zip(queries, results):
+        assert len(result) == monaco(q).count
+
+def test_aiter_backpressure(monaco):
+    async def slow_collect(features):
+        result = []
+        async for f in features.aiter():
+            result.append(f)
+            if len(result) % 100 == 0:
+                await asyncio.sleep(0.001)
+        return result
+    limited = Features("data/monaco", max_buffered_results=64)
+    before = limited.queue_stats["producer_waits"]
+    result = asyncio.run(slow_collect(limited))
+    assert len(result) == limited.count
+    stats = limited.queue_stats
+    assert stats["max_buffered_results"] == 64
+    assert stats["producer_waits"] > before
+    assert stats["buffered_results"] >= 0
+    assert limited("w[highway]").queue_stats["max_buffered_results"] == 64
+    # The limit belongs to the object, not to the file
+    assert monaco.queue_stats["max_buffered_results"] == 8192
+    assert Features("data/monaco").queue_stats["max_buffered_results"] == 8192
+
+def test_exit_with_pending_aiter():
+    # The interpreter must shut down cleanly while feeder threads
+    # are still paused, waiting for a consumer that will never return
+    script = """
+import asyncio
+from geodesk import *
+async def run():
+    it = Features("data/monaco", max_buffered_results=16).aiter().__aiter__()
+    await it.__anext__()
+    raise SystemExit(0)
+asyncio.run(run())
+"""
+    result = subprocess.run([sys.executable, "-c", script], timeout=60)
+    assert result.returncode == 0
@@ -0,0 +1,31 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+import pytest
+from geodesk import *
+
+def check_distances(features, geom, units="meters"):
+    result = features.distances(geom, units=units)
+    assert len(result["id"]) == len(result["value"]) == features.count
+    expected = {}
+    for f in features:
+        expected[(f.is_node, f.is_way, f.id)] = distance(f, geom, units)
+    types = [(t == 0, t == 1) for t in result["type"]]
+    for (is_node, is_way), id, value in zip(types, result["id"], result["value"]):
+        assert value == pytest.approx(expected[(is_node, is_way, id)], abs=1e-3)
+
+def test_distances_to_point(monaco):
+    c = Coordinate(lon=7.4268, lat=43.7358)
+    check_distances(monaco("w[highway]"), c)
+    check_distances(monaco("n[amenity]"), c, units="feet")
+
+def test_distances_to_feature(monaco):
+    park = monaco.way(157719659)    # Petite Afrique
+    check_distances(monaco("a[leisure], w[highway=primary]"), park)
+    check_distances(monaco("a[building]"), park.shape)
+
+def test_distances_empty(monaco):
+    result = monaco("n[no_such_key]").distances(Coordinate(0, 0))
+    assert len(result["value"]) == 0
+    with pytest.raises(TypeError):
+        monaco("w[highway]").distances(Coordinate(0, 0), units="parsecs")
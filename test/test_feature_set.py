@@ -0,0 +1,72 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+import pytest
+from geodesk import *
+
+def test_feature_set(monaco):
+    streets = monaco("w[highway=residential]")
+    s = FeatureSet(streets)
+    assert len(s) == streets.count
+    assert set(s) == set(streets)
+    for street in streets:
+        assert street in s
+    for node in monaco("n[amenity]"):
+        assert node not in s
+    assert 5 not in s
+
+    street = streets.first
+    s.add(street)
+    assert len(s) == streets.count
+    s.discard(street)
+    assert street not in s
+    assert len(s) == streets.count - 1
+    s.discard(street)
+    assert len(s) == streets.count - 1
+
+    s.clear()
+    assert not s
+    with pytest.raises(TypeError):
+        s.add("not a feature")
+    with pytest.raises(TypeError):
+        s.update([street, 5])
+
+def test_feature_set_algebra(monaco):
+    restaurants = FeatureSet(monaco("na[amenity=restaurant]"))
+    named = FeatureSet(monaco("na[amenity][name]"))
+    both = set(monaco("na[amenity=restaurant][name]"))
+    assert set(restaurants & named) == both
+    assert set(restaurants | named) == set(restaurants) | set(named)
+    assert set(restaurants - named) == set(restaurants) - set(named)
+    assert set(restaurants ^ named) == set(restaurants) ^ set(named)
+    with pytest.raises(TypeError):
+        restaurants | set(named)
+
+def test_feature_set_iteration(monaco):
+    s = FeatureSet(monaco("n[place]"))
+    with pytest.raises(RuntimeError):
+        for f in s:
+            s.discard(f)
+
+def test_in_set(monaco):
+    streets = list(monaco("w[highway]"))[::7]
+    s = FeatureSet(streets)
+    selected = monaco.in_set(s)
+    assert set(selected) == set(streets)
+    assert selected.count == len(streets)
+    assert set(monaco("w[highway=residential]").in_set(s)) == \
+        set(f for f in streets if f.highway == "residential")
+    assert monaco.nodes.in_set(s).count == 0
+    assert monaco.in_set(FeatureSet()).count == 0
+
+    # The set's bounds narrow a bounding-box selection, rather than
+    # replacing its bounds
+    street = streets[0]
+    in_box = monaco(street.bounds)
+    selected_in_box = set(in_box.in_set(s))
+    assert street in selected_in_box
+    assert selected_in_box == set(in_box) & set(streets)
+
+    # The filter uses the contents of the set at the time it was applied
+    s.clear()
+    assert selected.count == len(streets)
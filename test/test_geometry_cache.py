@@ -0,0 +1,59 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+import subprocess
+import sys
+import pytest
+from geodesk import *
+
+def test_geometry_cache(monaco):
+    boundary = monaco("a[boundary=administrative]").first
+    before = monaco.geometry_cache_stats
+    shape = boundary.shape
+    again = boundary.shape
+    assert shape.equals(again)
+    assert shape is not again
+    stats = monaco.geometry_cache_stats
+    assert stats["hits"] > before["hits"]
+    assert stats["bytes"] <= stats["max_bytes"]
+
+    # The cached geometry is also used for distance and buffer
+    hits = stats["hits"]
+    for node in monaco("n[amenity=restaurant]")[:10]:
+        assert node.distance(boundary) >= 0
+    assert monaco.geometry_cache_stats["hits"] >= hits + 10
+
+    # ... and for spatial filters
+    hits = monaco.geometry_cache_stats["hits"]
+    inside = monaco("na[amenity=restaurant]").intersecting(boundary)
+    assert monaco.geometry_cache_stats["hits"] > hits
+    assert set(inside) == set(monaco("na[amenity=restaurant]")(boundary))
+
+def test_geometry_cache_budget(monaco):
+    try:
+        limited = Features("data/monaco", geometry_cache=0)
+        for street in monaco("w[highway]")[:20]:
+            street.shape
+        stats = limited.geometry_cache_stats
+        assert stats["max_bytes"] == 0
+        assert stats["entries"] == 0
+        assert stats["bytes"] == 0
+        with pytest.raises(ValueError):
+            Features("data/monaco", geometry_cache=-1)
+    finally:
+        Features("data/monaco", geometry_cache=None)
+    assert monaco.geometry_cache_stats["max_bytes"] == 64 * 1024 * 1024
+
+def test_cache_freed_with_store():
+    # Once the last reference to a store is gone, its cache (and
+    # budget) goes with it
+    script = """
+import gc
+from geodesk import *
+limited = Features("data/monaco", geometry_cache=0)
+del limited
+gc.collect()
+assert Features("data/monaco").geometry_cache_stats["max_bytes"] == 64 * 1024 * 1024
+"""
+    result = subprocess.run([sys.executable, "-c", script], timeout=60)
+    assert result.returncode == 0
@@ -0,0 +1,50 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+import pytest
+from geodesk import *
+
+def location(f):
+    if f.is_node:
+        return f.x, f.y
+    b = f.bounds
+    return (b.minx + b.maxx) // 2, (b.miny + b.maxy) // 2
+
+def in_box(f, box):
+    x, y = location(f)
+    return box.minx <= x <= box.maxx and box.miny <= y <= box.maxy
+
+def test_grid_count(monaco):
+    box = monaco("a[leisure=park]").first.bounds.buffer(meters=500)
+    grid = monaco.grid(50, box=box)
+    rows, columns = grid.shape
+    assert rows > 1 and columns > 1
+    assert grid.format == "I"
+    assert sum(sum(row) for row in grid.tolist()) == sum(1 for f in monaco(box) if in_box(f, box))
+
+def test_grid_length_area(monaco):
+    box = monaco("a[leisure=park]").first.bounds.buffer(meters=1000)
+    ways = monaco("w[highway]")
+    lengths = ways.grid(200, box=box, value="length")
+    assert lengths.format == "d"
+    expected = sum(f.length for f in ways(box) if in_box(f, box))
+    assert sum(sum(row) for row in lengths.tolist()) == pytest.approx(expected)
+    parks = monaco("a[leisure=park]")
+    areas = parks.grid(200, box=box, value="area")
+    expected = sum(f.area for f in parks(box) if in_box(f, box))
+    assert sum(sum(row) for row in areas.tolist()) == pytest.approx(expected)
+
+def test_grid_bounded_selection(monaco):
+    box = monaco("a[leisure=park]").first.bounds
+    assert monaco(box).grid(20).shape == monaco.grid(20, box=box).shape
+
+def test_grid_errors(monaco):
+    with pytest.raises(ValueError):
+        monaco.grid(100)        # no box
+    box = monaco("a[leisure=park]").first.bounds
+    with pytest.raises(ValueError):
+        monaco.grid(0, box=box)
+    with pytest.raises(ValueError):
+        monaco.grid(100, box=box, value="height")
+    with pytest.raises(ValueError):
+        monaco.grid(1, box=Box(w=-180, s=-80, e=180, n=80))
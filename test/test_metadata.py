@@ -41,3 +41,21 @@ def test_tiles(world):
         total_size += tile.size
     assert len(tiles) > 25000
     assert total_size > 90 * 1024 * 1024 * 1024     # world should be > 90 GB
+
+def test_string_objects(monaco):
+    # Global strings are shared, rather than created for every tag
+    a, b = list(monaco("w[highway=residential]"))[:2]
+    assert dict(a.tags)["highway"] is dict(b.tags)["highway"]
+    key_a = next(k for k, v in a.tags if k == "highway")
+    key_b = next(k for k, v in b.tags if k == "highway")
+    assert key_a is key_b
+    strings = monaco.strings
+    assert strings[10] is strings[10]
+    assert strings[-1] == list(strings)[-1]
+    assert dict(a.tags)["highway"] is strings[list(strings).index("residential")]
+
+def test_role_objects(monaco):
+    roles = {}
+    for rel in monaco.relations("[type=multipolygon]"):
+        for member in rel.members:
+            assert roles.setdefault(member.role, member.role) is member.role
@@ -0,0 +1,29 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+import importlib.util
+import pytest
+import geodesk
+from geodesk import _geodesk
+
+def test_second_module_instance(monaco):
+    # With multi-phase initialization, each import creates its own
+    # module object
+    spec = importlib.util.find_spec("geodesk._geodesk")
+    other = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(other)
+    assert other is not _geodesk
+    assert other.Features is geodesk.Features
+    assert other.QueryError is geodesk.QueryError
+    assert other.Features("data/monaco").count == monaco.count
+    with pytest.raises(other.QueryError):
+        monaco("this is not a query")
+
+
+def test_shared_gil_subinterpreter():
+    # Legacy sub-interpreters (which share the main GIL) can import
+    # the module, as they could before multi-phase initialization
+    testcapi = pytest.importorskip("_testcapi")
+    code = ("import geodesk\n"
+        "assert geodesk.Features('data/monaco').count > 0\n")
+    assert testcapi.run_in_subinterp(code) == 0
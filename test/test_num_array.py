@@ -0,0 +1,43 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+import math
+import pytest
+from geodesk import *
+
+def test_num_array(monaco):
+    # Features whose value isn't a number (e.g. maxspeed=none) get NaN,
+    # the same as features that lack the tag (unlike Feature.num(),
+    # which returns 0 in either case)
+    streets = monaco("w[highway]")
+    result = streets.num_array("maxspeed")
+    assert len(result["id"]) == len(result["value"]) == streets.count
+    # Strings are parsed the same way as by Feature.num()
+    nums = {f.id: f.num("maxspeed") for f in streets}
+    for id, value in zip(result["id"], result["value"]):
+        if math.isnan(value):
+            assert nums[id] == 0
+        else:
+            assert value == pytest.approx(nums[id])
+    assert any(not math.isnan(v) for v in result["value"])
+    assert list(result["id"]) == sorted(result["id"])
+
+def test_num_array_non_numeric(monaco):
+    # None of the highway values are numbers
+    streets = monaco("w[highway]")
+    values = streets.num_array("highway")["value"]
+    assert len(values) == streets.count
+    assert all(math.isnan(v) for v in values)
+    assert set(streets.num_array("highway", default=-1)["value"]) == {-1}
+    unlimited = monaco("w[maxspeed=none]")
+    assert all(math.isnan(v) for v in unlimited.num_array("maxspeed")["value"])
+    assert all(f.num("maxspeed") == 0 for f in unlimited)
+
+def test_num_array_default(monaco):
+    places = monaco("n[place]")
+    result = places.num_array("no_such_key", default=-1)
+    assert set(result["value"]) == {-1}
+    assert result["value"].format == "d"
+    assert len(monaco("n[no_such_key]").ways.num_array("maxspeed")["value"]) == 0
+    with pytest.raises(TypeError):
+        places.num_array(5)
@@ -0,0 +1,32 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+from collections import Counter
+from operator import attrgetter
+import pytest
+from geodesk import *
+
+def test_parallel_map(monaco):
+    for features in (monaco, monaco("w[highway]"), monaco("na[amenity]")):
+        results = Counter(features.parallel_map(attrgetter("id", "osm_type"), processes=2))
+        assert results == Counter((f.id, f.osm_type) for f in features)
+
+def test_parallel_map_bounds(monaco):
+    park = monaco("a[leisure=park]").first
+    features = monaco(park.bounds)
+    results = Counter(features.parallel_map(attrgetter("id", "osm_type"), processes=2))
+    assert results == Counter((f.id, f.osm_type) for f in features)
+
+def test_parallel_map_empty(monaco):
+    assert list(monaco("n[no_such_key]").parallel_map(str)) == []
+
+def test_parallel_map_unsupported(monaco):
+    street = monaco("w[highway][name]").first
+    with pytest.raises(TypeError):
+        street.nodes.parallel_map(str)
+    with pytest.raises(TypeError):
+        monaco.within(street).parallel_map(str)
+    with pytest.raises(ValueError):
+        monaco.parallel_map(str, chunk="feature")
+    with pytest.raises(ValueError):
+        monaco.parallel_map(str, processes=0)
@@ -0,0 +1,51 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+import pickle
+from concurrent.futures import ProcessPoolExecutor
+import pytest
+from geodesk import *
+
+def test_pickle_feature(monaco):
+    for f in monaco("w[highway]")[:50]:
+        f2 = pickle.loads(pickle.dumps(f))
+        assert f2 == f
+        assert f2.tags == f.tags
+    node = monaco("n[name]").first
+    assert pickle.loads(pickle.dumps(node)) == node
+
+def test_pickle_member_role(monaco):
+    route = monaco("r[route]").first
+    for member in route.members:
+        m2 = pickle.loads(pickle.dumps(member))
+        assert m2 == member
+        assert m2.role == member.role
+
+def test_pickle_features(monaco):
+    selections = [
+        monaco,
+        monaco("na[amenity=restaurant]"),
+        monaco("w[highway]")("w[name]"),
+        monaco.ways,
+        monaco(monaco("a[leisure=park]").first.bounds)("n"),
+    ]
+    for s in selections:
+        s2 = pickle.loads(pickle.dumps(s))
+        assert set(s2) == set(s)
+
+def test_pickle_unsupported(monaco):
+    street = monaco("w[highway][name]").first
+    with pytest.raises(TypeError):
+        pickle.dumps(street.nodes)
+    with pytest.raises(pickle.PicklingError):
+        pickle.dumps(monaco("n").within(street))
+    with pytest.raises(pickle.PicklingError):
+        pickle.dumps(monaco.in_set(FeatureSet([street])))
+
+def count_features(features):
+    return features.count
+
+def test_pickle_across_processes(monaco):
+    restaurants = monaco("na[amenity=restaurant]")
+    with ProcessPoolExecutor(max_workers=2) as pool:
+        assert pool.submit(count_features, restaurants).result() == restaurants.count
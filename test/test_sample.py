@@ -0,0 +1,51 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+from collections import Counter
+import pytest
+from geodesk import *
+
+def test_sample(monaco):
+    buildings = monaco("a[building]")
+    sample = buildings.sample(50, seed=42)
+    assert len(sample) == 50
+    assert len(set(sample)) == 50
+    assert all(f in buildings for f in sample)
+    # The same seed always yields the same sample
+    assert buildings.sample(50, seed=42) == sample
+    assert set(buildings.sample(50, seed=43)) != set(sample)
+    # A larger sample with the same seed includes the smaller one
+    assert set(sample) <= set(buildings.sample(100, seed=42))
+
+def test_sample_all(monaco):
+    parks = monaco("a[leisure=park]")
+    assert set(parks.sample(parks.count + 10)) == set(parks)
+    assert parks.sample(0) == []
+    assert monaco("n[no_such_key]").ways.sample(5) == []
+
+def test_sample_stratified(monaco):
+    features = monaco("na[amenity]")
+    total = features.count
+    n = total // 4
+    sample = features.sample(n, seed=1, stratify="tile")
+    assert len(sample) == n
+    assert len(set(sample)) == n
+    per_tile = Counter()
+    tile_of = {}
+    for tile in features.tiles:
+        for f in tile.features("na[amenity]"):
+            tile_of[f] = tile.tip
+    for f in sample:
+        per_tile[tile_of[f]] += 1
+    for tile in features.tiles:
+        count = tile.features("na[amenity]").count
+        # Each tile contributes in proportion to its share (+/- rounding)
+        assert abs(per_tile[tile.tip] - count * n / total) < 1
+
+def test_sample_errors(monaco):
+    with pytest.raises(ValueError):
+        monaco.sample(-1)
+    with pytest.raises(ValueError):
+        monaco.sample(5, stratify="country")
+    with pytest.raises(TypeError):
+        monaco("w[highway]").first.nodes.sample(5)
@@ -0,0 +1,32 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+from collections import Counter
+import pytest
+from geodesk import *
+
+def test_distinct(monaco):
+    features = monaco("[highway]")
+    expected = Counter(f.str("highway") for f in features)
+    distinct = features.distinct("highway")
+    assert distinct == dict(expected)
+    counts = list(distinct.values())
+    assert counts == sorted(counts, reverse=True)
+
+def test_distinct_numbers_and_local_keys(monaco):
+    # Numeric values are returned in the same form as Feature.str()
+    features = monaco("a[building:levels]")
+    assert features.distinct("building:levels") == \
+        dict(Counter(f.str("building:levels") for f in features))
+    assert monaco.distinct("no_such_key") == {}
+    assert monaco("n[no_such_key]").ways.distinct("highway") == {}
+    with pytest.raises(TypeError):
+        monaco.distinct(5)
+
+def test_key_stats(monaco):
+    features = monaco("w[highway]")
+    expected = Counter()
+    for f in features:
+        expected.update(key for key, value in f.tags)
+    assert features.key_stats() == dict(expected)
+    assert monaco("n[no_such_key]").ways.key_stats() == {}
@@ -0,0 +1,42 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+from geodesk import *
+import pytest
+
+def sequential_area(features):
+    return sum(f.area for f in features)
+
+def sequential_length(features):
+    return sum(f.length for f in features)
+
+def test_parallel_measures(monaco):
+    buildings = monaco("a[building]")
+    assert buildings.area == pytest.approx(sequential_area(buildings))
+    streets = monaco("w[highway]")
+    assert streets.length == pytest.approx(sequential_length(streets))
+
+def test_store_threads(monaco):
+    limited = Features("data/monaco", threads=1)
+    buildings = limited("a[building]")
+    assert buildings.area == pytest.approx(sequential_area(buildings))
+    assert monaco("a[building]").area == pytest.approx(buildings.area)
+    with pytest.raises(TypeError):
+        Features("data/monaco", thread_count=2)
+    with pytest.raises(ValueError):
+        Features("data/monaco", threads=0)
+
+def test_set_thread_pool(monaco):
+    streets = monaco("w[highway]")
+    expected = streets.length
+    try:
+        set_thread_pool(2)
+        assert streets.length == pytest.approx(expected)
+        set_thread_pool(2, affinity=[0])
+        assert streets.length == pytest.approx(expected)
+        with pytest.raises(ValueError):
+            set_thread_pool(-1)
+        with pytest.raises(ValueError):
+            set_thread_pool(2, affinity=[-1])
+    finally:
+        set_thread_pool(0)
@@ -0,0 +1,62 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+import os
+from concurrent.futures import ThreadPoolExecutor
+from geodesk import *
+import test_concur
+
+# A mix of the test_concur workloads: world queries, related-feature
+# iteration, tag access and formatting
+WORKLOADS = [
+    test_concur.italian_restaurant_count,
+    test_concur.waynode_iter_count,
+    test_concur.street_crossing_count,
+    test_concur.member_iter_count,
+    test_concur.parent_iter_count,
+    test_concur.tags_key_len,
+    test_concur.tags_int_sum,
+    test_concur.centroid_hash,
+    test_concur.geojson_len,
+]
+
+def helper_run_all(world):
+    return [func(world) for func in WORKLOADS]
+
+def test_threaded_workloads():
+    # Runs the workloads on many threads at once (which take turns
+    # holding the GIL, but release it while they wait for queries),
+    # which must produce the same results as running them one after
+    # the other
+    world = Features("data/monaco")
+    expected = helper_run_all(world)
+    threads = min(os.cpu_count() or 1, 8)
+    with ThreadPoolExecutor(max_workers=threads) as pool:
+        results = list(pool.map(lambda _: helper_run_all(world),
+            range(threads * 2)))
+    for res in results:
+        assert res == expected
+
+def test_shared_iterator():
+    # Threads that pull from the same iterator must each get different
+    # features (a thread that calls next() while another one fetches
+    # the next batch gets a ValueError, and simply tries again)
+    world = Features("data/monaco")
+    features = world("na[amenity]")
+    it = iter(features)
+
+    def drain(_):
+        taken = []
+        while True:
+            try:
+                taken.append(next(it))
+            except StopIteration:
+                return taken
+            except ValueError:
+                pass
+
+    threads = min(os.cpu_count() or 1, 8)
+    with ThreadPoolExecutor(max_workers=threads) as pool:
+        results = list(pool.map(drain, range(threads)))
+    taken = [f for result in results for f in result]
+    assert len(taken) == len(set(taken)) == features.count
@@ -1,6 +1,8 @@
 # Copyright (c) 2024 Clarisma / GeoDesk contributors
 # SPDX-License-Identifier: LGPL-3.0-only
 
+from collections import Counter
+import pytest
 from geodesk import *
 
 def test_world_tiles(world):
@@ -31,4 +33,54 @@ def test_member_tiles(world):
         count += 1
     m.show()    
     print (f"{country.members.count} members in {count} tiles")
-    
\ No newline at end of file
+    
+def test_tile_features(monaco):
+    tiles = monaco.tiles
+    seen = Counter()
+    for tile in tiles:
+        for f in tile.features:
+            seen[f] += 1
+    # Every feature belongs to exactly one tile
+    assert seen == Counter(monaco)
+    for tile in tiles:
+        assert set(tile.features("w[highway]")) == set(tile.features).intersection(monaco("w[highway]"))
+
+def test_tile_navigation(monaco):
+    tiles = monaco.tiles
+    roots = [tile for tile in tiles if tile.parent is None]
+    assert len(roots) == 1
+    for tile in tiles:
+        assert tile.is_loaded
+        assert tile.id == str(tile)
+        assert tile.shape.bounds == pytest.approx(
+            (tile.bounds.minx, tile.bounds.miny, tile.bounds.maxx, tile.bounds.maxy))
+        for child in tile.children:
+            assert child.parent == tile
+            assert child.zoom > tile.zoom
+        if tile.parent is not None:
+            assert tile in tile.parent.children
+
+def test_tile_stats(monaco):
+    stats = monaco.tile_stats()
+    tiles = monaco.tiles
+    assert len(stats["tip"]) == len(tiles)
+    for i, tile in enumerate(tiles):
+        assert stats["tip"][i] == tile.tip
+        assert stats["zoom"][i] == tile.zoom
+        assert stats["size"][i] == tile.size
+        assert stats["revision"][i] == tile.revision
+        assert stats["exports"][i] == len(tile.exports)
+        features = tile.features
+        assert stats["nodes"][i] == features.nodes.count
+        assert stats["ways"][i] == features.ways.count
+        assert stats["relations"][i] == features.relations.count
+        assert stats["foreign_relations"][i] <= stats["relations"][i]
+    assert sum(stats["nodes"]) + sum(stats["ways"]) + sum(stats["relations"]) == monaco.count
+    view = memoryview(stats["ways"])
+    assert view.format == "I" and view.tolist() == stats["ways"].tolist()
+
+def test_tile_stats_query(monaco):
+    stats = monaco("w[highway]").tile_stats()
+    assert sum(stats["ways"]) == monaco("w[highway]").count
+    assert sum(stats["nodes"]) == 0
+    assert len(monaco("n[no_such_key]").nodes.ways.tile_stats()["tip"]) == 0
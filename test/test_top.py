@@ -0,0 +1,37 @@
+# Copyright (c) 2026 Clarisma / GeoDesk contributors
+# SPDX-License-Identifier: LGPL-3.0-only
+
+import pytest
+from geodesk import *
+
+def ranking(features, value):
+    scored = [(value(f), f) for f in features]
+    scored.sort(key=lambda s: s[0], reverse=True)
+    return [s[0] for s in scored]
+
+def test_top_by_tag(monaco):
+    buildings = monaco("a[building][building:levels]")
+    top = buildings.top(10, by="building:levels")
+    assert len(top) == 10
+    assert [f.num("building:levels") for f in top] == \
+        ranking(buildings, lambda f: f.num("building:levels"))[:10]
+    assert all(f in buildings for f in top)
+
+def test_top_by_measure(monaco):
+    ways = monaco.ways
+    top = ways.top(5, by="length")
+    assert [f.length for f in top] == pytest.approx(ranking(ways, lambda f: f.length)[:5])
+    areas = monaco.relations("a")
+    top = areas.top(3, by="area")
+    assert [f.area for f in top] == pytest.approx(ranking(areas, lambda f: f.area)[:3])
+
+def test_top_edge_cases(monaco):
+    parks = monaco("a[leisure=park]")
+    assert parks.top(0, by="area") == []
+    assert set(parks.top(parks.count + 5, by="area")) == set(parks)
+    assert monaco("n[place]").top(5, by="no_such_key") == []
+    assert monaco("n[no_such_key]").ways.top(5, by="length") == []
+    with pytest.raises(ValueError):
+        parks.top(-1, by="area")
+    with pytest.raises(TypeError):
+        parks.top(1, by=5)